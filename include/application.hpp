@@ -14,16 +14,21 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #pragma once
+#include <string>
 #include <vector>
 
 #include "game.hpp"
 #include "gui/gui.hpp"
+#include "misc/configuration.hpp"
+#include "rendering/gpuTimer.hpp"
+#include "rendering/renderTarget.hpp"
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 
 class System;
+class Benchmark;
 struct KeyEvent;
 struct FramebufferSizeEvent;
 struct MouseButtonEvent;
@@ -34,30 +39,85 @@ static void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
 static void cursorPos_callback(GLFWwindow* window, double x, double y);
 static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+static void focus_callback(GLFWwindow* window, int focused);
+static void iconify_callback(GLFWwindow* window, int iconified);
+static void refresh_callback(GLFWwindow* window);
+
+struct ApplicationOptions {
+    /// @brief Renders into an offscreen framebuffer of an invisible window, that does not need a display
+    bool headless = false;
+    int width = 1280;
+    int height = 720;
+
+    /// @brief Number of measured benchmark frames. If it is zero, the benchmark runs until the camera path ends
+    int benchmarkFrames = 0;
+    /// @brief Camera path of the benchmark. The default path is used if it is empty
+    std::string cameraPath;
+    std::string benchmarkReport;
+    /// @brief Frames with a longer cpu time in milliseconds are counted as hitches
+    float frameBudget = 1000.0f / 60.0f;
+
+    unsigned int seed = Configuration::worldSeed;
+
+    /// @brief Runs the systems one after another and reports undeclared component writes. Only available in debug builds
+    bool validateSystems = false;
+
+    inline bool benchmarkEnabled() const {
+        return benchmarkFrames > 0 || !cameraPath.empty();
+    }
+};
 
 class Application {
   private:
+    ApplicationOptions options;
+
     GLFWwindow* window;
+    /// @brief Offscreen framebuffer in headless mode
+    RenderTarget* renderTarget = nullptr;
+    Benchmark* benchmark = nullptr;
 
     Gui* gui = nullptr;
     Game* game = nullptr;
+    GpuTimer* gpuTimer = nullptr;
 
     bool stopRequested = false;
 
+    FramePacing framePacing;
+    bool focused = true;
+    bool iconified = false;
+    /// @brief Set by input and window events. While the game is paused, frames are only rendered if a redraw was requested
+    bool redrawRequested = true;
+
+    friend void focus_callback(GLFWwindow*, int);
+    friend void iconify_callback(GLFWwindow*, int);
+    friend void refresh_callback(GLFWwindow*);
+
     friend void cursorPos_callback(GLFWwindow*, double, double);
     glm::vec2 lastCursorPos = glm::vec2(400.0f, 300.0f);
 
     void init();
+    void createWindow();
+
+    /// @brief Updates and renders one frame
+    void frame();
+    /// @brief Waits until the frame time of the target frame rate has passed
+    void limitFrameRate(double frameStart) const;
+
+    /// @brief Renders the benchmark frames as fast as possible with a fixed time step
+    void runBenchmark();
 
   public:
     float updateTime = 0.0f;
 
-    Application();
+    Application(const ApplicationOptions& options = {});
 
     void run();
 
     void stop();
 
+    void setFramePacing(FramePacing pacing);
+    FramePacing getFramePacing() const;
+
     inline Game* getGame() const {
         return game;
     }
@@ -70,12 +130,25 @@ class Application {
         return gui;
     }
 
+    inline GpuTimer* getGpuTimer() const {
+        return gpuTimer;
+    }
+
     inline GameState getGameState() const {
         return game->getState();
     }
 
     GLFWwindow* getWindow() const;
 
+    /// @brief The framebuffer the scene is rendered into
+    inline unsigned int getFramebuffer() const {
+        return renderTarget != nullptr ? renderTarget->getFramebuffer() : 0;
+    }
+
+    inline const ApplicationOptions& getOptions() const {
+        return options;
+    }
+
     void onKeyEvent(KeyEvent& e);
     void onFramebufferSizeEvent(FramebufferSizeEvent& e);
     void onMouseMoveEvent(MouseMoveEvent& e);
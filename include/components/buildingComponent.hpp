@@ -38,4 +38,8 @@ struct BuildingComponent : public AssignableComponent {
     inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
         registry.emplace<BuildingComponent>(entity, type, gridPosition, rotation, size, preview);
     }
+
+    inline void hashState(StateHash& hash) const {
+        hash(type, gridPosition, rotation, size, preview);
+    }
 };
@@ -37,4 +37,8 @@ struct CameraComponent : public Component<false> {
     void calculateMatrices(const TransformationComponent& transform);
 
     void calculateVectors();
+
+    inline void hashState(StateHash& hash) const {
+        hash(up, front, right, width, height, fov, near, far, yaw, pitch, projectionMatrix, viewMatrix);
+    }
 };
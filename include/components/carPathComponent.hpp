@@ -16,7 +16,10 @@
 #pragma once
 #include "component.hpp"
 
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -26,22 +29,33 @@ struct CarPath {
     std::vector<glm::vec3> pathOut;
 };
 
+using CarPaths = std::unordered_map<std::string, CarPath>;
+
 struct CarPathComponent : public AssignableComponent {
-    std::unordered_map<std::string, CarPath> paths;
+    /// @brief The paths are shared by all instances of an object, because they never change
+    std::shared_ptr<const CarPaths> paths;
 
-    inline CarPathComponent(std::unordered_map<std::string, CarPath>&& paths)
-        : paths(paths) {
+    inline CarPathComponent(CarPaths&& paths)
+        : paths(std::make_shared<const CarPaths>(std::move(paths))) {
+    }
+
+    inline CarPathComponent(const CarPaths& paths)
+        : paths(std::make_shared<const CarPaths>(paths)) {
     }
 
-    inline CarPathComponent(const std::unordered_map<std::string, CarPath>& paths)
+    inline CarPathComponent(const std::shared_ptr<const CarPaths>& paths)
         : paths(paths) {
     }
 
     inline CarPathComponent(std::initializer_list<std::pair<const std::string, CarPath>> paths = {})
-        : paths(paths) {
+        : paths(std::make_shared<const CarPaths>(paths)) {
     }
 
     inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
         registry.emplace<CarPathComponent>(entity, paths);
     }
 };
+
+template<>
+struct CopyOnAssign<CarPathComponent> : std::true_type {
+};
@@ -14,6 +14,8 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #pragma once
+#include "misc/stateHash.hpp"
+
 #include <entt/entt.hpp>
 
 /// TODO: Maybe remove assignable components and use std::copy_constructible
@@ -29,9 +31,16 @@ struct Component<true> {
 using AssignableComponent = Component<true>;
 
 #include <concepts>
+#include <type_traits>
 
 template<typename T>
 concept ComponentType = (std::derived_from<T, Component<false>> || std::derived_from<T, Component<true>>)&&std::copy_constructible<T>;
 
 template<typename T>
 concept AssignableComponentType = std::derived_from<T, Component<true>> && std::copy_constructible<T>;
+
+/// @brief Is specialized for components whose `assignToEntity` only emplaces a copy of the component, so that many copies can be inserted at once.
+/// It is not inherited, because derived components can finalize the copies in `assignToEntity`
+template<typename T>
+struct CopyOnAssign : std::false_type {
+};
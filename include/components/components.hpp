@@ -21,12 +21,17 @@
 #include "carPathComponent.hpp"
 #include "debugComponent.hpp"
 #include "environmentComponent.hpp"
+#include "instanceCullingComponent.hpp"
 #include "instancedMeshComponent.hpp"
+#include "interpolationComponent.hpp"
 #include "lightComponent.hpp"
 #include "meshComponent.hpp"
+#include "occluderComponent.hpp"
+#include "parentComponent.hpp"
 #include "parkingComponent.hpp"
 #include "roadComponent.hpp"
 #include "roadMeshComponent.hpp"
+#include "staticBatchComponent.hpp"
 #include "sunLightComponent.hpp"
 #include "terrainComponent.hpp"
 #include "transformationComponent.hpp"
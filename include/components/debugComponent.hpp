@@ -24,4 +24,8 @@ enum class DebugMode : unsigned int {
 
 struct DebugComponent : public Component<false> {
     DebugMode mode = DebugMode::OFF;
+
+    inline void hashState(StateHash& hash) const {
+        hash(mode);
+    }
 };
@@ -0,0 +1,62 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "component.hpp"
+
+#include "misc/frustum.hpp"
+#include "rendering/instanceBuffer.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/// @brief Culling state of the instances of one object
+struct CulledInstances {
+    /// @brief World space bounding spheres of all instances
+    BoundingSpheres bounds;
+
+    /// @brief Per instance visibility of the current culling pass
+    std::vector<unsigned char> visibility;
+    /// @brief Indices and distances of the instances that passed the frustum test
+    std::vector<std::pair<unsigned int, float>> candidates;
+    /// @brief Detail level of every instance in the last frame
+    std::vector<unsigned char> lodLevels;
+    /// @brief Compacted transformations of the visible instances per detail level
+    std::vector<std::vector<glm::mat4>> visibleTransforms;
+
+    /// @brief Streamed instances for the camera pass per detail level
+    std::vector<InstanceBuffer> cameraInstances;
+    /// @brief Streamed instances for the shadow pass per geometry detail level
+    std::vector<InstanceBuffer> shadowInstances;
+
+    inline void hashState(StateHash& hash) const {
+        hash(bounds, visibility, candidates, lodLevels, visibleTransforms, cameraInstances, shadowInstances);
+    }
+};
+
+/// @brief Enables per instance frustum culling for the instances of a `MultiInstancedMeshComponent`
+struct InstanceCullingComponent : public Component<false> {
+    std::unordered_map<std::string, CulledInstances> instances;
+
+    /// @brief Has to be set if the instance transformations were modified
+    bool boundsOutdated = true;
+
+    inline void hashState(StateHash& hash) const {
+        hash(instances, boundsOutdated);
+    }
+};
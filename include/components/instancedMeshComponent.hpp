@@ -34,6 +34,11 @@ struct InstancedMeshComponent : public MeshComponent, public InstancedMesh<glm::
     inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
         registry.emplace<InstancedMeshComponent>(entity, mesh, transformations);
     }
+
+    inline void hashState(StateHash& hash) const {
+        MeshComponent::hashState(hash);
+        InstancedMesh::hashState(hash);
+    }
 };
 
 struct MultiInstancedMeshComponent : public MeshComponent {
@@ -46,5 +51,9 @@ struct MultiInstancedMeshComponent : public MeshComponent {
     inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
         registry.emplace<MultiInstancedMeshComponent>(entity, mesh, transforms);
     }
+
+    inline void hashState(StateHash& hash) const {
+        hash(mesh, lod, transforms);
+    }
 };
 
@@ -0,0 +1,36 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "component.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+/// @brief Stores the transformation of the previous simulation step, so that the rendered transformation can be interpolated between two steps
+struct InterpolationComponent : public Component<false> {
+    glm::vec3 previousPosition;
+    glm::quat previousRotation;
+    glm::vec3 previousScale;
+
+    inline InterpolationComponent(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+        : previousPosition(position), previousRotation(rotation), previousScale(scale) {
+    }
+
+    inline void hashState(StateHash& hash) const {
+        hash(previousPosition, previousRotation, previousScale);
+    }
+};
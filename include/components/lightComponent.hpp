@@ -40,6 +40,10 @@ struct LightComponent : public AssignableComponent {
 
     void calculateLightMatrices(const CameraComponent& camera);
 
+    inline void hashState(StateHash& hash) const {
+        hash(direction, ambient, diffuse, specular, lightView, lightProjection);
+    }
+
   private:
     static std::vector<glm::vec4> getFrustumInWorldSpace(const glm::mat4& projection, const glm::mat4& view);
 
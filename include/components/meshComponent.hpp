@@ -22,6 +22,9 @@
 struct MeshComponent : public AssignableComponent {
     MeshPtr mesh;
 
+    /// @brief The detail level that is currently rendered
+    unsigned int lod = 0;
+
     inline MeshComponent(const MeshPtr& mesh)
         : mesh(mesh) {
     }
@@ -29,4 +32,12 @@ struct MeshComponent : public AssignableComponent {
     inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
         registry.emplace<MeshComponent>(entity, mesh);
     }    
+
+    inline void hashState(StateHash& hash) const {
+        hash(mesh, lod);
+    }
+};
+
+template<>
+struct CopyOnAssign<MeshComponent> : std::true_type {
 };
@@ -0,0 +1,87 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "component.hpp"
+
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/// @brief A simplified hull that is rasterized into the occlusion buffer to hide objects behind the entity
+struct OccluderComponent : public AssignableComponent {
+    /// @brief Triangle list in model space. The hull has to lie completely inside the rendered geometry
+    std::vector<glm::vec3> triangles;
+    /// @brief Bounding sphere of the hull in model space
+    glm::vec4 boundingSphere = glm::vec4(0.0f);
+
+    inline OccluderComponent() {
+    }
+
+    inline OccluderComponent(const std::vector<glm::vec3>& triangles)
+        : triangles(triangles) {
+        updateBoundingSphere();
+    }
+
+    /// @brief Creates an occluder from an axis aligned box
+    static inline OccluderComponent fromBox(const glm::vec3& min, const glm::vec3& max) {
+        std::vector<glm::vec3> corners(8);
+        for (int i = 0; i < 8; i++) {
+            corners[i] = glm::vec3(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z);
+        }
+
+        constexpr int faces[6][4] = {
+            {0, 2, 6, 4},
+            {1, 5, 7, 3},
+            {0, 4, 5, 1},
+            {2, 3, 7, 6},
+            {0, 1, 3, 2},
+            {4, 6, 7, 5},
+        };
+
+        std::vector<glm::vec3> triangles;
+        triangles.reserve(36);
+        for (const auto& face : faces) {
+            triangles.insert(triangles.end(), {corners[face[0]], corners[face[1]], corners[face[2]], corners[face[0]], corners[face[2]], corners[face[3]]});
+        }
+
+        return OccluderComponent(triangles);
+    }
+
+    inline void updateBoundingSphere() {
+        glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+        for (const glm::vec3& vertex : triangles) {
+            min = glm::min(min, vertex);
+            max = glm::max(max, vertex);
+        }
+
+        boundingSphere = triangles.empty() ? glm::vec4(0.0f) : glm::vec4(0.5f * (min + max), 0.5f * glm::length(max - min));
+    }
+
+    inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
+        registry.emplace<OccluderComponent>(entity, triangles);
+    }
+
+    inline void hashState(StateHash& hash) const {
+        hash(triangles, boundingSphere);
+    }
+};
+
+template<>
+struct CopyOnAssign<OccluderComponent> : std::true_type {
+};
@@ -0,0 +1,41 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "component.hpp"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+/// @brief Attaches the entity to a parent. The position, rotation and scale of its transformation are relative to the parent, the matrix is in world space
+struct ParentComponent : public Component<false> {
+    entt::entity parent;
+    /// @brief Number of ancestors. The storage is sorted by it, so that parents are updated before their children
+    unsigned int depth = 1;
+
+    /// @brief Cached matrix relative to the parent
+    glm::mat4 localTransform = glm::mat4(1.0f);
+    /// @brief Versions of the own and the parent matrix when the world matrix was calculated
+    unsigned int version = 0;
+    unsigned int parentVersion = 0;
+
+    inline ParentComponent(entt::entity parent)
+        : parent(parent) {
+    }
+
+    inline void hashState(StateHash& hash) const {
+        hash(parent, depth, localTransform, version, parentVersion);
+    }
+};
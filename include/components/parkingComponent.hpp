@@ -16,21 +16,19 @@
 #pragma once
 #include "component.hpp"
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 
-/// @brief Describes a parking spot and the entity occupying it.
+/// @brief Describes a parking spot.
 struct ParkingSpot {
     /// @brief An id to identify the parking spot
     const std::string id;
     /// @brief The position of the parking spot
     glm::vec3 position;
-    /// @brief True if the parking spot is occupied by an entity, otherwise false
-    bool occupied = false;
-    /// @brief The entity occupying the parking spot
-    entt::entity entity = entt::null;
 
     inline ParkingSpot(const std::string& id, const glm::vec3& position)
         : id(id), position(position) {
@@ -38,10 +36,21 @@ struct ParkingSpot {
 };
 
 struct ParkingComponent : public AssignableComponent {
-    std::vector<ParkingSpot> parkingSpots;
+    /// @brief The parking spots are shared by all instances of an object, because they never change
+    std::shared_ptr<const std::vector<ParkingSpot>> parkingSpots;
+    /// @brief The entity occupying each parking spot or `entt::null` if the spot is free
+    std::vector<entt::entity> occupants;
 
     inline ParkingComponent(const std::vector<ParkingSpot>& parkingSpots)
-        : parkingSpots(parkingSpots) {
+        : ParkingComponent(std::make_shared<const std::vector<ParkingSpot>>(parkingSpots)) {
+    }
+
+    inline ParkingComponent(const std::shared_ptr<const std::vector<ParkingSpot>>& parkingSpots)
+        : parkingSpots(parkingSpots), occupants(parkingSpots->size(), entt::null) {
+    }
+
+    inline bool isOccupied(std::size_t spot) const {
+        return occupants[spot] != entt::null;
     }
 
     inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
@@ -71,4 +71,8 @@ struct RoadComponent : public AssignableComponent {
         RoadComponent& road = registry.emplace<RoadComponent>(entity, roadTiles);
         road.meshOutdated = true;
     }
+
+    inline void hashState(StateHash& hash) const {
+        hash(roadTiles, borders, meshOutdated, graph.getNodes(), graph.getEdges());
+    }
 };
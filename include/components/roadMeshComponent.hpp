@@ -17,6 +17,7 @@
 #include <map>
 
 #include "misc/roads/roadTile.hpp"
+#include "misc/stateHash.hpp"
 
 struct RoadMeshComponent {
     std::map<RoadTypes, std::map<RoadTileTypes, InstancedMesh<glm::mat4>>> roadMeshes;
@@ -24,4 +25,8 @@ struct RoadMeshComponent {
 #if DEBUG
     Geometry* graphDebugMesh = new Geometry(VertexAttributes{VertexAttribute{3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0u}}, GL_LINES);
 #endif
+
+    inline void hashState(StateHash& hash) const {
+        hash(roadMeshes);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "component.hpp"
+#include "resources/mesh.hpp"
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/// @brief Holds the merged static geometry of one chunk
+struct StaticBatchComponent : public Component<false> {
+    /// @brief The merged geometry in chunk space. One geometry per material and culling mode
+    MeshPtr mesh;
+    /// @brief Bounding box of the merged geometry in chunk space
+    glm::vec3 boundsMin = glm::vec3(0.0f), boundsMax = glm::vec3(0.0f);
+
+    /// @brief The entities whose geometry is part of the batch
+    std::vector<entt::entity> members;
+
+    /// @brief `true` if the batch contains the roads of the chunk
+    bool containsRoads = false;
+
+    /// @brief `true` if the batch is up to date and can be rendered instead of its members
+    bool valid = false;
+
+    /// @brief Incremented every time the content of the chunk changes
+    unsigned int revision = 0;
+
+    inline void hashState(StateHash& hash) const {
+        hash(mesh, boundsMin, boundsMax, members, containsRoads, valid, revision);
+    }
+};
+
+/// @brief Marks an entity whose geometry is rendered by the static batch of its chunk
+struct StaticBatchedComponent : public Component<false> {
+    glm::ivec2 chunkPosition;
+
+    inline StaticBatchedComponent(const glm::ivec2& chunkPosition)
+        : chunkPosition(chunkPosition) {
+    }
+
+    inline void hashState(StateHash& hash) const {
+        hash(chunkPosition);
+    }
+};
@@ -24,4 +24,9 @@ struct SunLightComponent : public LightComponent {
     SunLightComponent(float angle, const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular)
         : LightComponent(glm::vec3(glm::cos(angle), glm::sin(angle), 0.0f), ambient, diffuse, specular), angle(angle) {
     }
+
+    inline void hashState(StateHash& hash) const {
+        LightComponent::hashState(hash);
+        hash(angle);
+    }
 };
@@ -24,20 +24,48 @@
 
 struct TerrainComponent : public AssignableComponent {
     /// @brief A 2d array of height values for each cell
-    float** heightValues;
+    float** heightValues = nullptr;
     /// @brief A 2d array of the surface types
-    TerrainSurfaceTypes** surfaceTypes;
+    TerrainSurfaceTypes** surfaceTypes = nullptr;
     /// @brief True if the mesh is generated
     bool meshGenerated = false;
+    /// @brief Range of the height values, including the water surface
+    float minHeight = 0.0f, maxHeight = 0.0f;
 
     inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
         int cellsPerDirection = Configuration::chunkSize / Configuration::cellSize;
 
+        // every copy owns its arrays
         TerrainComponent& newTerrain = registry.emplace<TerrainComponent>(entity);
+        newTerrain.minHeight = minHeight;
+        newTerrain.maxHeight = maxHeight;
+
+        newTerrain.heightValues = new float*[cellsPerDirection + 1];
+        newTerrain.surfaceTypes = new TerrainSurfaceTypes*[cellsPerDirection];
         for (int x = 0; x < cellsPerDirection + 1; x++) {
+            newTerrain.heightValues[x] = new float[cellsPerDirection + 1];
             for (int y = 0; y < cellsPerDirection + 1; y++) {
                 newTerrain.heightValues[x][y] = heightValues[x][y];
             }
+
+            if (x < cellsPerDirection) {
+                newTerrain.surfaceTypes[x] = new TerrainSurfaceTypes[cellsPerDirection];
+                for (int y = 0; y < cellsPerDirection; y++) {
+                    newTerrain.surfaceTypes[x][y] = surfaceTypes[x][y];
+                }
+            }
+        }
+    }
+
+    inline void hashState(StateHash& hash) const {
+        hash(heightValues, surfaceTypes, meshGenerated, minHeight, maxHeight);
+
+        for (int x = 0; heightValues != nullptr && x < Configuration::cellsPerChunk + 1; x++) {
+            hash.addBytes(heightValues[x], (Configuration::cellsPerChunk + 1) * sizeof(float));
+        }
+
+        for (int x = 0; surfaceTypes != nullptr && x < Configuration::cellsPerChunk; x++) {
+            hash.addBytes(surfaceTypes[x], Configuration::cellsPerChunk * sizeof(TerrainSurfaceTypes));
         }
     }
 };
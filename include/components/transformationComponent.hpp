@@ -26,11 +26,30 @@ struct TransformationComponent : public AssignableComponent {
     glm::vec3 scale;
 
     glm::mat4 transform;
+    /// @brief The matrix does not match the position, rotation and scale. Set it after changing them directly
+    bool dirty = false;
+    /// @brief Incremented whenever the matrix changes, so that attached entities notice it
+    unsigned int version = 0;
 
     TransformationComponent(const glm::vec3& position, const glm::quat& rotation = glm::quat(), const glm::vec3& scale = glm::vec3(1));
 
     void calculateTransform();
 
+    /// @brief Matrix of the position, rotation and scale
+    glm::mat4 calculateMatrix() const;
+
+    inline void setTransform(const glm::mat4& transform) {
+        this->transform = transform;
+        version++;
+    }
+
+    /// @brief Recalculates the matrix only if the transformation changed
+    inline void updateTransform() {
+        if (dirty) {
+            calculateTransform();
+        }
+    }
+
     void translate(const glm::vec3& translation);
     void setPosition(const glm::vec3& position);
 
@@ -42,4 +61,8 @@ struct TransformationComponent : public AssignableComponent {
     void setScale(const glm::vec3& scale);
 
     void assignToEntity(const entt::entity entity, entt::registry& registry) const override;
+
+    inline void hashState(StateHash& hash) const {
+        hash(position, rotation, scale, transform, dirty, version);
+    }
 };
@@ -32,4 +32,12 @@ struct VelocityComponent : public AssignableComponent {
     inline void assignToEntity(const entt::entity entity, entt::registry& registry) const override {
         registry.emplace<VelocityComponent>(entity, linearVelocity, angularVelocity);
     }
+
+    inline void hashState(StateHash& hash) const {
+        hash(linearVelocity, angularVelocity);
+    }
+};
+
+template<>
+struct CopyOnAssign<VelocityComponent> : std::true_type {
 };
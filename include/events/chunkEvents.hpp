@@ -31,9 +31,11 @@ struct ChunkEvent : public EntityEvent {
 };
 
 struct ChunkCreatedEvent : public ChunkEvent {
+    /// @brief Time in seconds from the request of the chunk until it was created
+    float streamingLatency;
 
-    inline ChunkCreatedEvent(const entt::entity entity, const glm::ivec2& position)
-        : ChunkEvent(entity, position) {
+    inline ChunkCreatedEvent(const entt::entity entity, const glm::ivec2& position, float streamingLatency = 0.0f)
+        : ChunkEvent(entity, position), streamingLatency(streamingLatency) {
     }
 };
 
@@ -17,5 +17,6 @@
 #include "entityEvent.hpp"
 
 struct EntityMoveEvent : public EntityEvent {
-
+    /// @brief Only the last movement of an entity in a frame is delivered
+    static constexpr bool coalesce = true;
 };
@@ -16,6 +16,8 @@
 #pragma once
 #include "resources/resourceManager.hpp"
 
+#include "misc/eventBus.hpp"
+#include "misc/systemScheduler.hpp"
 #include "misc/terrain.hpp"
 #include "misc/typedefs.hpp"
 
@@ -27,6 +29,10 @@
 #include <fstream>
 
 class System;
+class RenderSystem;
+class CameraSystem;
+class HierarchySystem;
+class CarSystem;
 class Application;
 
 enum class GameState {
@@ -36,17 +42,43 @@ enum class GameState {
 };
 
 class Game {
+    /// @brief Systems that are updated with a fixed time step
     std::vector<System*> systems;
+    /// @brief Systems that are updated once per frame before the simulation
+    std::vector<System*> inputSystems;
+    /// @brief Simulation systems that move entities. The transformations are stored before each of their steps, so that the frame can be interpolated between the last two steps
+    std::vector<System*> concurrentSystems;
+    /// @brief Systems that are updated once per frame after the simulation
+    std::vector<System*> renderSystems;
+    RenderSystem* renderSystem;
+    CameraSystem* cameraSystem;
+    HierarchySystem* hierarchySystem;
+    CarSystem* carSystem;
+
+    /// @brief Frame time that was not simulated yet
+    float accumulator = 0.0f;
 
     ResourceManager resourceManager;
 
     entt::registry registry;
     entt::dispatcher eventDispatcher;
+    /// @brief Events that are posted during the frame. They are delivered to the dispatcher between the simulation and the rendering
+    EventBus eventBus;
+
+    /// @brief Runs the systems of a frame concurrently according to their declared component access
+    SystemScheduler scheduler;
 
     Application* app;
 
     void init();
 
+    /// @brief Keeps the transformations of the last simulation step for the interpolation
+    void storePreviousTransforms();
+    /// @brief Adds the interpolation to moving entities
+    void addInterpolationComponents();
+    /// @brief Sets the rendered transformations between the last two simulation steps
+    void interpolateTransforms(float alpha);
+
     GameState state = GameState::RUNNING;
 
 #if DEBUG
@@ -66,6 +98,14 @@ class Game {
     entt::dispatcher& getEventDispatcher();
     ResourceManager& getResourceManager();
 
+    inline Application* getApp() const {
+        return app;
+    }
+
+    inline CameraSystem* getCameraSystem() const {
+        return cameraSystem;
+    }
+
     void update(float dt);
     void reloadResources();
 
@@ -80,6 +120,12 @@ class Game {
     template<typename Event>
     void raiseEvent(Event& args);
 
+    /// @brief Queues the event for the next flush of the frame. Can be called from worker threads
+    template<typename Event>
+    inline void postEvent(Event args) {
+        eventBus.post(std::move(args));
+    }
+
 #if DEBUG
     void log(const std::string& message);
 #endif
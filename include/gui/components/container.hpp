@@ -23,6 +23,8 @@ class Container : public Widget {
   protected:
     std::vector<Widget*> children;
 
+    void arrangeChildren() override;
+
   public:
     Container(const std::string& id, Gui* gui, const glm::vec4& backgroundColor);
     virtual void addChild(Widget* child);
@@ -35,8 +37,6 @@ class Container : public Widget {
 
     void render() const override;
 
-    virtual void setChildConstraints() = 0;
-
     void handleMouseButtonEvent(MouseButtonEvent& e) override;
     void handleMouseMoveEvent(MouseMoveEvent& e) override;
 };
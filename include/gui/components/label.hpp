@@ -20,10 +20,21 @@
 
 #include "rendering/textRenderer.hpp"
 #include <string>
+#include <string_view>
 
 class Label : public virtual Widget {
-  public:
+  protected:
     std::string text;
+
+    /// @brief The cached layout of the text. It is reset if the text changes
+    mutable TextLayoutPtr layout;
+
+    const TextLayout& getLayout() const;
+
+    glm::vec2 measure(const Rectangle& parentBox) const override;
+    bool fitsContent() const;
+
+  public:
     glm::vec4 textColor;
     int textSize;
 
@@ -31,7 +42,11 @@ class Label : public virtual Widget {
 
     Label(const std::string& id, Gui* gui, const glm::vec4& backgroundColor, const std::string& text, const int textSize = 24, const glm::vec4& textColor = colors::white);
 
-    virtual Rectangle getBox() const override;
+    const std::string& getText() const;
+    void setText(std::string_view text);
+
+    /// @brief Invalidates the layout if the size of the text changed after glyphs were added to the glyph cache
+    virtual void update() override;
 
     virtual void render() const override;
 };
@@ -17,6 +17,13 @@
 #include "container.hpp"
 
 class StackPanel : public Container {
+  protected:
+    glm::vec2 measure(const Rectangle& parentBox) const override;
+    void arrangeChildren() override;
+
+    /// @brief Sets the position or size constraint of the child along the stack direction
+    void setChildConstraint(Widget* child, bool position, const Constraint& value) const;
+
   public:
     enum class StackOrientation {
         ROW,
@@ -39,7 +46,4 @@ class StackPanel : public Container {
 
     StackPanel(const std::string& id, Gui* gui, StackOrientation orientation, const glm::vec4 backgroundColor, ItemAligment itemAligment = ItemAligment::CENTER);
 
-    void setChildConstraints() override;
-
-    Rectangle getBox() const override;
 };
@@ -32,7 +32,22 @@ class Widget {
     Gui* gui;
     bool visible = false;
 
+    Constraints constraints;
+
+    /// @brief The box the widget was arranged in last
+    Rectangle box = Rectangle{0, 0, 0, 0};
+    /// @brief The box of the parent the widget was arranged in
+    Rectangle parentBox = Rectangle{0, 0, 0, 0};
+    /// @brief Set if the constraints or the content changed since the last arrangement
+    bool layoutDirty = true;
+
+    /// @brief Computes the size of the widget from the size constraints
+    virtual glm::vec2 measure(const Rectangle& parentBox) const;
+    /// @brief Arranges the children in the box of the widget
+    virtual void arrangeChildren();
+
     friend class Gui;
+    friend class StackPanel;
 
   public:
     const std::string id;
@@ -45,7 +60,6 @@ class Widget {
     Widget* parent = nullptr;
     glm::vec4 backgroundColor;
     float cornerRadius = 0.0f;
-    Constraints constraints;
 
     virtual void show();
     virtual void hide();
@@ -55,7 +69,20 @@ class Widget {
 
     virtual void render() const;
 
-    virtual Rectangle getBox() const;
+    const Constraints& getConstraints() const;
+    void setX(const Constraint& x);
+    void setY(const Constraint& y);
+    void setWidth(const Constraint& width);
+    void setHeight(const Constraint& height);
+
+    /// @brief Marks the layout of the widget and its parents as outdated
+    void invalidateLayout();
+
+    /// @brief Computes the box of the widget and its children. Nothing is done if the layout is valid and the parent box did not change
+    void arrange(const Rectangle& parentBox);
+
+    /// @brief Returns the box the widget was arranged in
+    const Rectangle& getBox() const;
 
     virtual void handleMouseButtonEvent(MouseButtonEvent& e);
     virtual void handleMouseMoveEvent(MouseMoveEvent& e);
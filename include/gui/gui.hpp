@@ -16,8 +16,7 @@
 #pragma once
 #include "gui/components/widget.hpp"
 
-#include "rendering/renderQuad.hpp"
-#include "rendering/shader.hpp"
+#include "rendering/guiRenderer.hpp"
 #include "rendering/textRenderer.hpp"
 
 #include <stack>
@@ -45,7 +44,7 @@ class Gui {
   private:
     Application* app;
 
-    RenderQuad quad;
+    GuiRenderer* renderer;
     float width, height;
 
     PauseMenu* pauseMenu;
@@ -58,9 +57,8 @@ class Gui {
     std::stack<Widget*> navigation;
     std::vector<Widget*> widgets;
 
-    ShaderProgram* guiShader = new ShaderProgram("res/shaders/renderQuad.vert", "res/shaders/renderQuad.frag");
-
     void init();
+    void updateLayout();
 
   public:
     Gui(Application* app, float width, float height);
@@ -74,14 +72,16 @@ class Gui {
     void hideWarning() const;
 
     Application* getApp() const;
-    ShaderProgram* getShader() const;
-    const RenderQuad& getRenderQuad() const;
+    GuiRenderer* getRenderer() const;
 
     void setScreenSize(float width, float height);
     Rectangle getBox() const;
 
     void update();
 
+    /// @brief Returns `true` if text is still missing glyphs, so the gui has to be updated and rendered again
+    bool hasPendingWork() const;
+
     void render() const;
 
     void handleMouseButtonEvent(MouseButtonEvent& e);
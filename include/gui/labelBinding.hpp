@@ -0,0 +1,78 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "observable.hpp"
+
+#include <array>
+#include <functional>
+#include <string_view>
+
+class Label;
+
+/// @brief Updates the text of a label from a value. The text is formatted at most once per interval and the label is only changed if the formatted text differs
+class LabelBinding {
+  public:
+    static constexpr size_t bufferSize = 128;
+
+  protected:
+    Label* label;
+
+    /// @brief Minimum time between two updates of the label in seconds
+    float interval;
+    float elapsed;
+    bool changed = true;
+
+    std::array<char, bufferSize> buffer;
+    std::array<char, bufferSize> formatBuffer;
+    size_t length = 0;
+
+    /// @brief Writes the text into the buffer
+    /// @return The length of the text
+    virtual int format(char* buffer, size_t size) const = 0;
+
+  public:
+    LabelBinding(Label* label, float interval);
+    virtual ~LabelBinding() = default;
+
+    /// @brief Updates the label if the value changed and the interval elapsed
+    /// @param dt The time since the last update
+    void update(float dt);
+};
+
+/// @brief Binds an observable value to a label
+template<typename T>
+class ObservableLabelBinding : public LabelBinding {
+  public:
+    using Formatter = std::function<int(char* buffer, size_t size, const T& value)>;
+
+  protected:
+    T value;
+    Formatter formatter;
+
+    inline int format(char* buffer, size_t size) const override {
+        return formatter(buffer, size, value);
+    }
+
+  public:
+    inline ObservableLabelBinding(Label* label, Observable<T>& observable, Formatter&& formatter, float interval = 0.0f)
+        : LabelBinding(label, interval), value(observable.get()), formatter(std::forward<Formatter>(formatter)) {
+        observable.subscribe([this](const T& value) {
+            this->value = value;
+            changed = true;
+        });
+    }
+};
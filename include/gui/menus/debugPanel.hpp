@@ -15,10 +15,45 @@
  */
 #pragma once
 #include "../components/stackPanel.hpp"
+#include "../labelBinding.hpp"
+
+#include "rendering/renderStats.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+class Label;
 
 class DebugPanel : public StackPanel {
+  private:
+    std::vector<std::unique_ptr<LabelBinding>> bindings;
+
+    Label* addValueLabel(const std::string& id, int textSize);
+
+    void bindRenderCounters(const std::string& id, const char* name, Observable<RenderCounters>& observable);
+
   public:
+    Observable<float> fps;
+    Observable<glm::vec3> sunDirection;
+    /// @brief Sun angle in degrees
+    Observable<float> sunAngle;
+    Observable<glm::vec3> cameraPosition;
+    /// @brief Gpu times of the shadow, scene, debug and gui pass in milliseconds
+    Observable<glm::vec4> gpuTimes;
+    /// @brief Render statistics of the last frame per pass and per component type
+    std::array<Observable<RenderCounters>, renderPassesCount> passCounters;
+    std::array<Observable<RenderCounters>, RenderStats::categoriesCount> categoryCounters;
+
     DebugPanel(Gui* gui);
 
+    /// @brief Binds the observable to a new label of the panel
+    template<typename T>
+    void bind(const std::string& id, Observable<T>& observable, typename ObservableLabelBinding<T>::Formatter&& formatter, float interval = 0.0f, int textSize = 12) {
+        bindings.push_back(std::make_unique<ObservableLabelBinding<T>>(addValueLabel(id, textSize), observable, std::forward<typename ObservableLabelBinding<T>::Formatter>(formatter), interval));
+    }
+
     void update() override;
 };
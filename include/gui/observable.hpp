@@ -0,0 +1,51 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <functional>
+#include <vector>
+
+/// @brief Value that notifies its subscribers when it changes
+template<typename T>
+class Observable {
+  public:
+    using Delegate = std::function<void(const T&)>;
+
+  private:
+    T value{};
+    std::vector<Delegate> subscribers;
+
+  public:
+    inline void subscribe(Delegate&& delegate) {
+        subscribers.push_back(std::forward<Delegate>(delegate));
+    }
+
+    /// @brief Sets the value. The subscribers are only notified if the value changed
+    inline void set(const T& value) {
+        if (this->value == value) {
+            return;
+        }
+
+        this->value = value;
+        for (const Delegate& delegate : subscribers) {
+            delegate(this->value);
+        }
+    }
+
+    inline const T& get() const {
+        return value;
+    }
+};
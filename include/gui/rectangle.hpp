@@ -22,4 +22,8 @@ struct Rectangle {
         return x >= this->x && x <= this->x + this->width &&
                y >= this->y && y <= this->y + this->height;
     }
+
+    inline bool operator==(const Rectangle& other) const {
+        return x == other.x && y == other.y && width == other.width && height == other.height;
+    }
 };
@@ -0,0 +1,89 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "misc/cameraPath.hpp"
+#include "rendering/renderPass.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+class Game;
+class GpuTimer;
+struct ApplicationOptions;
+struct ChunkCreatedEvent;
+template<typename Event>
+struct EventBatch;
+
+/// @brief Plays a camera path with a fixed time step and reports the frame times, the chunk streaming latency and the hitches
+class Benchmark {
+  public:
+    /// @brief Frames at the start that are not measured, so that the first chunks are generated and the gpu times are available. The camera path starts after them
+    static constexpr int warmupFrames = 60;
+    /// @brief Speed of the camera along the default path in meters per second
+    static constexpr float defaultPathSpeed = 20.0f;
+    /// @brief Duration of the default path in seconds
+    static constexpr float defaultPathDuration = 30.0f;
+
+  private:
+    struct FrameRecord {
+        /// @brief Times in milliseconds
+        float cpuTime;
+        std::array<float, renderPassesCount> gpuTimes;
+
+        int chunksStreamed;
+        /// @brief Maximum streaming latency of the chunks created in the frame in milliseconds
+        float chunkLatency;
+
+        /// @brief The gpu times are read back some frames later. The last frames of the benchmark have none, and passes whose results were not available are not measured
+        std::array<bool, renderPassesCount> gpuMeasured = {};
+    };
+
+    Game* game;
+    CameraPath path;
+
+    /// @brief Number of measured frames. If it is zero, the benchmark runs until the camera path ends
+    int frames;
+    int frame = 0;
+    float frameBudget;
+
+    std::string reportFilename;
+
+    std::vector<FrameRecord> records;
+    std::vector<float> chunkLatencies;
+    int frameChunksStreamed = 0;
+    float frameChunkLatency = 0.0f;
+
+    /// @brief The camera flies diagonally over the terrain and turns slowly, so that new chunks are streamed in
+    static CameraPath createDefaultPath();
+
+    void onChunksCreated(const EventBatch<ChunkCreatedEvent>& batch);
+
+    /// @brief Nearest rank percentile of the values
+    static float percentile(std::vector<float> values, float p);
+
+  public:
+    Benchmark(Game* game, const ApplicationOptions& options);
+
+    bool finished() const;
+
+    /// @brief Stores the cpu time of the rendered frame and the gpu times of the frame they were measured in
+    void recordFrame(float cpuTime, const GpuTimer& gpuTimer);
+
+    /// @brief Writes the summary and, if a report file is set, the summary and the times of every frame
+    void writeReport() const;
+};
@@ -0,0 +1,55 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+struct CameraKeyframe {
+    /// @brief Time of the keyframe in seconds since the start of the path
+    float time;
+    glm::vec3 position;
+    /// @brief Camera angles in degrees
+    float yaw, pitch;
+};
+
+/// @brief Camera path through keyframes that are interpolated with a Catmull-Rom spline
+class CameraPath {
+  private:
+    std::vector<CameraKeyframe> keyframes;
+
+  public:
+    /// @brief Loads a path file with one `time x y z yaw pitch` keyframe per line. Lines starting with `#` are ignored
+    /// @return `true` if the file contained at least one keyframe
+    bool load(const std::string& filename);
+    bool save(const std::string& filename) const;
+
+    /// @brief Appends a keyframe. The keyframes have to be added in chronological order
+    void addKeyframe(const CameraKeyframe& keyframe);
+    void clear();
+
+    inline bool empty() const {
+        return keyframes.empty();
+    }
+
+    /// @brief Time of the last keyframe in seconds
+    float getDuration() const;
+
+    /// @brief Returns the interpolated camera state at the specified time
+    CameraKeyframe sample(float time) const;
+};
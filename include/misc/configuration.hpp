@@ -17,6 +17,15 @@
 #include <map>
 #include <string>
 
+enum class FramePacing {
+    /// @brief Frames are synchronized with the display refresh rate
+    VSYNC,
+    /// @brief Frames are limited to the target frame rate
+    TARGET_FPS,
+    /// @brief Frames are not limited
+    UNLIMITED
+};
+
 class Configuration {
   public:
     /// @brief The size of one building cell in meters
@@ -41,13 +50,74 @@ class Configuration {
         static constexpr int heightLevelsCount = heightRange / heightSteps;
     };
 
+    /// @brief Frame pacing mode used at startup
+    static constexpr FramePacing framePacing = FramePacing::TARGET_FPS;
+    /// @brief Frame rate of the `TARGET_FPS` pacing mode
+    static constexpr int targetFps = 144;
+    /// @brief Time before the end of a frame from which on the frame limiter spins instead of sleeping, because sleeping is not precise enough
+    static constexpr float frameLimiterSpinTime = 0.002f;
+    /// @brief Rate at which events are checked while the game is paused. Frames are only rendered after input events or while glyphs are loaded
+    static constexpr int idleFps = 10;
+    /// @brief Frame rate of a running game whose window is not focused
+    static constexpr int backgroundFps = 30;
+
+    /// @brief Number of simulation steps per second
+    static constexpr int simulationTickRate = 60;
+    /// @brief Duration of one simulation step in seconds
+    static constexpr float simulationTimeStep = 1.0f / simulationTickRate;
+    /// @brief Maximum number of simulation steps per frame. If a frame takes longer, the simulation falls behind instead of taking even longer frames
+    static constexpr int maxSimulationSteps = 5;
+    static_assert(backgroundFps * maxSimulationSteps > simulationTickRate, "The simulation steps of a background frame have to cover its frame time");
+
     /// @brief The distance of the camera above the terrain
     static constexpr float cameraHeight = 15.0f;
+    /// @brief Time between two keyframes of a recorded camera path in seconds
+    static constexpr float cameraPathRecordInterval = 0.5f;
+    /// @brief File the recorded camera path is written to
+    static constexpr const char* cameraPathFile = "camera_path.txt";
+
+    /// @brief Seed of the terrain and the vegetation
+    static constexpr unsigned int worldSeed = 1;
+
+    /// @brief Maximum number of simulated cars. Fewer cars are spawned if the roads are full
+    static constexpr int maxCars = 100000;
+    /// @brief Desired velocity of the cars in world units per second
+    static constexpr float carVelocity = 8.0f;
+    /// @brief Maximum acceleration of the cars
+    static constexpr float carAcceleration = 2.0f;
+    /// @brief Comfortable deceleration of the cars
+    static constexpr float carDeceleration = 3.0f;
+    /// @brief Length of a car along its lane
+    static constexpr float carLength = 2.0f;
+    /// @brief Distance the cars keep to the car in front while standing
+    static constexpr float carMinimumGap = 1.0f;
+    /// @brief Time gap the cars keep to the car in front while driving
+    static constexpr float carTimeHeadway = 1.0f;
+    /// @brief Time after which a road node stops admitting cars from the same side, so that the other sides get their turn
+    static constexpr float intersectionGreenTime = 5.0f;
+    /// @brief Distance to a road node from which a waiting car asks the node to admit its side
+    static constexpr float intersectionApproachDistance = 10.0f;
+
+    /// @brief Distance from the camera up to which vegetation instances are rendered
+    static constexpr float vegetationDrawDistance = 350.0f;
+    /// @brief Width of the band at the end of the draw distance in which vegetation instances are faded out
+    static constexpr float vegetationFadeDistance = 50.0f;
+    /// @brief Maximum number of vegetation instances rendered per frame. The nearest instances are kept
+    static constexpr unsigned int maxVegetationInstances = 2048;
+
+    /// @brief Relative margin around the screen size thresholds of mesh detail levels that prevents switching back and forth
+    static constexpr float lodHysteresis = 0.1f;
+
+    /// @brief Resolution of the cpu occlusion depth buffer. The width has to be a multiple of four
+    static constexpr int occlusionBufferWidth = 256;
+    static constexpr int occlusionBufferHeight = 128;
+    /// @brief Number of horizontal bands of the occlusion buffer that are rasterized in parallel
+    static constexpr int occlusionBands = 4;
+    /// @brief Occluders whose projected size relative to the screen height is smaller are not rasterized
+    static constexpr float minOccluderScreenSize = 0.05f;
 
-    /// @brief Maximum number of cars
-    static constexpr int maxCars = 1;
-    /// @brief Velocity of one car
-    static constexpr float carVelocity = 1.0f;
+    /// @brief Time in seconds the content of a chunk has to stay unchanged before its static geometry is batched
+    static constexpr float staticBatchSettleTime = 0.5f;
 
     static constexpr unsigned int SHADOW_BUFFER_WIDTH = 4096;
     static constexpr unsigned int SHADOW_BUFFER_HEIGHT = 4096;
@@ -0,0 +1,146 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief Events of one type that were posted since the last flush. They are delivered to the handlers at once
+template<typename Event>
+struct EventBatch {
+    std::vector<Event> events;
+};
+
+/// @brief Events that define a static constexpr bool coalesce = true are merged by their entity, so that only the last event of an entity is delivered
+template<typename Event>
+concept CoalescedEvent = Event::coalesce;
+
+class EventQueueBase {
+  public:
+    virtual ~EventQueueBase() = default;
+
+    virtual void flush(entt::dispatcher& dispatcher) = 0;
+};
+
+/// @brief Lock-free multi-producer queue. Posted events are pushed onto an atomic list, the consumer takes the whole list on flush
+template<typename Event>
+class EventQueue : public EventQueueBase {
+  private:
+    struct Node {
+        Event event;
+        Node* next;
+    };
+
+    std::atomic<Node*> head = nullptr;
+
+  public:
+    ~EventQueue() override {
+        Node* node = head.exchange(nullptr, std::memory_order_acquire);
+        while (node != nullptr) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    inline void post(Event&& event) {
+        Node* node = new Node{std::move(event), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// @brief Takes the posted events in the order they were posted
+    inline std::vector<Event> take() {
+        Node* node = head.exchange(nullptr, std::memory_order_acquire);
+
+        std::vector<Event> events;
+        while (node != nullptr) {
+            Node* next = node->next;
+            events.push_back(std::move(node->event));
+            delete node;
+            node = next;
+        }
+
+        std::reverse(events.begin(), events.end());
+        return events;
+    }
+
+    void flush(entt::dispatcher& dispatcher) override {
+        EventBatch<Event> batch{take()};
+        if (batch.events.empty()) {
+            return;
+        }
+
+        if constexpr (CoalescedEvent<Event>) {
+            // keep the last event of every entity in the order of their last occurrence
+            std::unordered_map<entt::entity, std::size_t> lastEvents;
+            for (std::size_t i = 0; i < batch.events.size(); i++) {
+                lastEvents[batch.events[i].entity] = i;
+            }
+
+            std::vector<Event> coalesced;
+            coalesced.reserve(lastEvents.size());
+            for (std::size_t i = 0; i < batch.events.size(); i++) {
+                if (lastEvents[batch.events[i].entity] == i) {
+                    coalesced.push_back(std::move(batch.events[i]));
+                }
+            }
+
+            batch.events = std::move(coalesced);
+        }
+
+        dispatcher.trigger<EventBatch<Event>&>(batch);
+    }
+};
+
+/// @brief Collects events that are posted from any thread and delivers them in batches at the flush points of the frame.
+/// The event types are registered up front, so that posting never changes the bus itself
+class EventBus {
+  private:
+    std::vector<std::unique_ptr<EventQueueBase>> queues;
+    std::unordered_map<entt::id_type, EventQueueBase*> queuesByType;
+
+  public:
+    template<typename Event>
+    inline void registerEvent() {
+        const entt::id_type type = entt::type_hash<Event>::value();
+        if (queuesByType.contains(type)) {
+            return;
+        }
+
+        queues.emplace_back(std::make_unique<EventQueue<Event>>());
+        queuesByType[type] = queues.back().get();
+    }
+
+    /// @brief Queues the event until the next flush. Can be called from every thread
+    template<typename Event>
+    inline void post(Event event) {
+        auto it = queuesByType.find(entt::type_hash<Event>::value());
+        assert(it != queuesByType.end() && "The event type is not registered");
+
+        static_cast<EventQueue<Event>*>(it->second)->post(std::move(event));
+    }
+
+    /// @brief Delivers the queued events of every type in the order the types were registered. Events that are posted by the handlers are delivered on the next flush
+    void flush(entt::dispatcher& dispatcher);
+};
@@ -0,0 +1,59 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "misc/stateHash.hpp"
+
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/// @brief A list of bounding spheres stored as structure of arrays, so that several spheres can be tested at once
+struct BoundingSpheres {
+    std::vector<float> x, y, z, radius;
+
+    void clear();
+
+    void reserve(size_t count);
+
+    void push_back(const glm::vec3& center, float r);
+
+    size_t size() const;
+
+    inline void hashState(StateHash& hash) const {
+        hash(x, y, z, radius);
+    }
+};
+
+struct Frustum {
+    /// @brief The six clipping planes (left, right, bottom, top, near, far). The normals point to the inside
+    std::array<glm::vec4, 6> planes;
+
+    Frustum() = default;
+
+    /// @brief Extracts the clipping planes from the given matrix
+    /// @param viewProjection The combined projection and view matrix
+    Frustum(const glm::mat4& viewProjection);
+
+    /// @brief Determines if the sphere is at least partially inside the frustum
+    bool intersects(const glm::vec3& center, float radius) const;
+
+    /// @brief Tests all spheres against the frustum, four spheres at a time if SSE is available
+    /// @param spheres The spheres to test
+    /// @param visible Is set to 1 for every sphere that intersects the frustum. Must have the same size as `spheres`
+    /// @param combine If `true` the results are or-combined with the values already stored in `visible`
+    void testSpheres(const BoundingSpheres& spheres, std::vector<unsigned char>& visible, bool combine = false) const;
+};
@@ -0,0 +1,150 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// @brief Jobs with a higher priority are executed first. Threads that wait for a counter only help with jobs of at least the waited priority
+enum class JobPriority : unsigned int {
+    HIGH,
+    NORMAL,
+    LOW
+};
+
+constexpr unsigned int jobPrioritiesCount = 3;
+
+class JobCounter;
+
+struct Job {
+    std::function<void()> function;
+    /// @brief Counter that is decremented when the job is finished
+    JobCounter* counter = nullptr;
+    JobPriority priority = JobPriority::NORMAL;
+};
+
+/// @brief Counts the unfinished jobs of a group. Jobs that depend on the counter are scheduled when it reaches zero.
+/// A counter has to be waited for with JobSystem::wait before it is destroyed
+class JobCounter {
+  private:
+    friend class JobSystem;
+
+    std::atomic<unsigned int> count = 0;
+    mutable std::mutex mutex;
+    std::vector<Job> continuations;
+
+  public:
+    inline bool done() const {
+        return count.load(std::memory_order_acquire) == 0;
+    }
+};
+
+/// @brief Executes jobs on a fixed pool of worker threads. Every worker owns a deque per priority and steals from the others if it runs out of jobs
+class JobSystem {
+  private:
+    /// @brief Jobs of one worker. The owner takes jobs from the back, other threads steal from the front
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::array<std::deque<Job>, jobPrioritiesCount> jobs;
+    };
+
+    /// @brief One queue per worker and a shared queue for jobs submitted by other threads
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<bool> running = true;
+    std::atomic<unsigned int> queuedJobs = 0;
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+
+    JobSystem();
+
+    void workerLoop(unsigned int index);
+
+    void schedule(Job&& job);
+
+    /// @brief Takes a job of the given priority from the own queue or steals one from the other queues
+    bool takeJob(JobPriority priority, Job& job);
+
+    void finishJob(const Job& job);
+
+  public:
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    static JobSystem& get();
+
+    inline unsigned int getWorkersCount() const {
+        return workers.size();
+    }
+
+    /// @brief Schedules a job
+    /// @param function The function to execute
+    /// @param counter Counter that is incremented until the job is finished
+    /// @param priority The priority of the job
+    /// @param dependency The job is not started before this counter reaches zero
+    void submit(std::function<void()> function, JobCounter* counter = nullptr, JobPriority priority = JobPriority::NORMAL, JobCounter* dependency = nullptr);
+
+    /// @brief Schedules a job whose result can be polled without blocking
+    template<typename TFunction>
+    inline std::future<std::invoke_result_t<TFunction>> async(TFunction&& function, JobPriority priority = JobPriority::NORMAL) {
+        using TResult = std::invoke_result_t<TFunction>;
+
+        auto task = std::make_shared<std::packaged_task<TResult()>>(std::forward<TFunction>(function));
+        std::future<TResult> result = task->get_future();
+
+        submit([task]() { (*task)(); }, nullptr, priority);
+
+        return result;
+    }
+
+    /// @brief Runs one job whose priority is at least the given priority on the calling thread
+    /// @return `true` if a job was executed
+    bool runJob(JobPriority minPriority);
+
+    /// @brief Runs jobs on the calling thread until the counter reaches zero. Only jobs of at least the given priority are run,
+    /// so that waiting for frame critical work is not delayed by long background jobs
+    void wait(const JobCounter& counter, JobPriority helpPriority = JobPriority::HIGH);
+
+    /// @brief Splits the range into blocks of `grainSize` elements and calls `function(first, last)` for every block in parallel.
+    /// Returns when all blocks are processed
+    template<typename TFunction>
+    inline void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, TFunction&& function, JobPriority priority = JobPriority::HIGH) {
+        grainSize = std::max<std::size_t>(grainSize, 1);
+
+        JobCounter counter;
+        for (std::size_t first = begin; first < end; first += grainSize) {
+            const std::size_t last = std::min(first + grainSize, end);
+
+            submit([&function, first, last]() { function(first, last); }, &counter, priority);
+        }
+
+        wait(counter, priority);
+    }
+};
@@ -0,0 +1,77 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "misc/configuration.hpp"
+
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/// @brief A low resolution depth buffer that is rasterized on the cpu. Simplified occluders are drawn into it and bounding volumes can be tested against it before they are submitted for rendering
+class OcclusionBuffer {
+  public:
+    static constexpr int width = Configuration::occlusionBufferWidth;
+    static constexpr int height = Configuration::occlusionBufferHeight;
+
+  protected:
+    /// @brief Triangle in screen space. xy are pixel coordinates and z is the normalized device depth
+    struct ScreenTriangle {
+        std::array<glm::vec3, 3> vertices;
+        int minY, maxY;
+    };
+
+    /// @brief Depth values in normalized device coordinates, row by row starting at the bottom
+    std::vector<float> depth;
+    std::vector<ScreenTriangle> triangles;
+
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+
+    void addClippedTriangle(const std::array<glm::vec4, 3>& vertices);
+    void addScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+
+    void rasterizeRows(int minRow, int maxRow);
+    void rasterizeTriangle(const ScreenTriangle& triangle, int minRow, int maxRow);
+
+  public:
+    OcclusionBuffer();
+
+    /// @brief Resets the depth values and removes all occluders
+    /// @param viewProjection The combined projection and view matrix of the camera
+    void clear(const glm::mat4& viewProjection);
+
+    /// @brief Adds the triangles of an occluder. The occluder must lie completely inside the geometry it represents
+    /// @param triangles Triangle list in model space
+    /// @param model Transformation from model to world space
+    void addOccluder(const std::vector<glm::vec3>& triangles, const glm::mat4& model);
+
+    /// @brief Rasterizes all added occluders. The rows of the buffer are split into bands that are rasterized in parallel
+    void rasterize();
+
+    /// @brief Determines if the box is completely hidden behind the rasterized occluders
+    /// @param min Minimum corner in world space
+    /// @param max Maximum corner in world space
+    bool isOccluded(const glm::vec3& min, const glm::vec3& max) const;
+
+    /// @brief Determines if the sphere is completely hidden behind the rasterized occluders
+    /// @param center Center in world space
+    /// @param radius The radius of the sphere
+    bool isOccluded(const glm::vec3& center, float radius) const;
+
+    const std::vector<float>& getDepth() const;
+
+    unsigned int getTrianglesCount() const;
+};
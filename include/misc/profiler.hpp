@@ -0,0 +1,120 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef PROFILING
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(_MSC_VER)
+#define PROFILE_FUNCTION_NAME __FUNCSIG__
+#else
+#define PROFILE_FUNCTION_NAME __PRETTY_FUNCTION__
+#endif
+
+/// @brief Records the time until the end of the scope. The name has to be a string literal
+#define PROFILE_ZONE(name) const ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(PROFILE_FUNCTION_NAME)
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FUNCTION()
+#endif
+
+struct ProfileEvent {
+    const char* name;
+    /// @brief Start and end time in nanoseconds since the start of the profiler
+    int64_t start, end;
+};
+
+/// @brief Collects the profiling zones of all threads and exports them in the Chrome trace event format
+class Profiler {
+  public:
+    /// @brief Number of events that are kept per thread. Older events are overwritten
+    static constexpr size_t eventsPerThread = 1 << 16;
+
+  private:
+    /// @brief Events of one thread. Only the owning thread writes into the buffer, so no locking is needed
+    struct ThreadBuffer {
+        std::unique_ptr<ProfileEvent[]> events = std::make_unique<ProfileEvent[]>(eventsPerThread);
+        std::atomic<size_t> count = 0;
+
+        unsigned int id;
+        std::string name;
+    };
+
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    /// @brief Guards the list of buffers, which only changes when a thread records its first event
+    mutable std::mutex buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    /// @brief Events of the gpu. They are written by the thread that reads back the timer queries
+    std::shared_ptr<ThreadBuffer> gpuBuffer;
+
+    ThreadBuffer& getThreadBuffer();
+
+    static inline void record(ThreadBuffer& buffer, const char* name, int64_t start, int64_t end) {
+        const size_t index = buffer.count.load(std::memory_order_relaxed);
+        buffer.events[index % eventsPerThread] = ProfileEvent{name, start, end};
+        buffer.count.store(index + 1, std::memory_order_release);
+    }
+
+  public:
+    static Profiler& get();
+
+    inline int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    inline void record(const char* name, int64_t start, int64_t end) {
+        record(getThreadBuffer(), name, start, end);
+    }
+
+    /// @brief Records an event on the gpu track. The times have to be converted to the profiler clock
+    void recordGpu(const char* name, int64_t start, int64_t end);
+
+    /// @brief Names the calling thread in the exported trace
+    void setThreadName(const std::string& name);
+
+    /// @brief Writes the recorded events of all threads as Chrome trace event JSON
+    /// @return `true` if the file was written
+    bool writeTrace(const std::string& filename) const;
+};
+
+/// @brief Measures the time from its construction until it goes out of scope
+class ProfileZone {
+  private:
+    const char* name;
+    int64_t start;
+
+  public:
+    inline ProfileZone(const char* name)
+        : name(name), start(Profiler::get().now()) {
+    }
+
+    inline ~ProfileZone() {
+        Profiler& profiler = Profiler::get();
+        profiler.record(name, start, profiler.now());
+    }
+};
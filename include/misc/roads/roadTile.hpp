@@ -16,6 +16,8 @@
 #pragma once
 #include "roadTypes.hpp"
 
+#include "misc/stateHash.hpp"
+
 #include <functional>
 
 #include <glm/glm.hpp>
@@ -78,6 +80,10 @@ struct RoadTile {
 
     bool operator==(const RoadTile& other) const;
     bool operator!=(const RoadTile& other) const;
+
+    inline void hashState(StateHash& hash) const {
+        hash(tileType, rotation, roadType);
+    }
 };
 
 struct RoadRenderData {
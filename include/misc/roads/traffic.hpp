@@ -0,0 +1,119 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "misc/roads/roadGraph.hpp"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+/// @brief Lane of the traffic network. It follows an edge or a path across a road node.
+/// The vehicles on the lane are stored in separate arrays, ordered from the front to the back of the lane
+struct TrafficLane {
+    static constexpr unsigned int none = std::numeric_limits<unsigned int>::max();
+
+    /// @brief Points of the lane in world coords
+    RoadPath points;
+    /// @brief Distance of every point from the start of the lane
+    std::vector<float> distances;
+    float length = 0.0f;
+
+    /// @brief Start and end cell of an edge lane or the cell, entry side and exit side of a node lane. Identifies the lane when the network is rebuilt
+    glm::ivec4 key;
+    /// @brief Node that is crossed by the lane or `none` if the lane follows an edge
+    unsigned int node = none;
+    /// @brief Side at which the lane enters its node
+    unsigned int entrySide = 0;
+    /// @brief Lanes the vehicles can continue on at the end of the lane
+    std::vector<unsigned int> successors;
+
+    std::vector<float> positions;
+    std::vector<float> velocities;
+    std::vector<float> accelerations;
+    /// @brief Lane every vehicle continues on at the end of this lane
+    std::vector<unsigned int> nextLanes;
+
+    inline std::size_t getVehiclesCount() const {
+        return positions.size();
+    }
+
+    /// @brief Returns the position and the driving direction at the given distance from the start of the lane
+    std::pair<glm::vec3, glm::vec3> sample(float distance) const;
+};
+
+/// @brief Admission state of a road node. Only vehicles entering from one side at a time may cross the node.
+/// The sides with waiting vehicles are granted in turn
+struct TrafficNode {
+    static constexpr unsigned int noSide = 4;
+
+    /// @brief The side whose vehicles may enter or `noSide` if the node is free for the first vehicle
+    unsigned int grantedSide = noSide;
+    unsigned int occupants = 0;
+    /// @brief Time since the side was granted in seconds
+    float grantTime = 0.0f;
+    /// @brief Bit mask of the sides at which vehicles approached the node in the last step
+    unsigned int waitingSides = 0;
+};
+
+/// @brief Simulates the vehicles on the road graphs of all chunks. Vehicles follow the intelligent driver model on their lane
+/// and wait at the stop line of a node until it admits them
+class TrafficNetwork {
+  private:
+    /// @brief Number of lanes updated by one job
+    static constexpr std::size_t lanesPerJob = 64;
+
+    std::vector<TrafficLane> lanes;
+    std::vector<TrafficNode> nodes;
+    std::mt19937 random;
+    std::size_t vehiclesCount = 0;
+
+    static float calculateAcceleration(float velocity, float gap, float leaderVelocity);
+
+    /// @brief Returns `true` if a vehicle may enter the lane, which requires free space at its start and the admission of its node
+    bool canEnter(unsigned int lane) const;
+    unsigned int chooseNextLane(const TrafficLane& lane);
+
+    void calculateAccelerations(TrafficLane& lane) const;
+    static void integrate(TrafficLane& lane, float dt);
+    /// @brief Passes the nodes whose granted side expired or has no vehicles left to the next waiting side
+    void updateGrants(float dt);
+    /// @brief Moves the vehicles that passed the end of their lane to the next lane. Runs serially, because it modifies several lanes and nodes
+    void transferVehicles();
+    void enterLane(unsigned int lane, float position, float velocity);
+
+  public:
+    TrafficNetwork();
+
+    /// @brief Creates the lanes from the road graphs of the chunks. The vehicles of lanes that still exist are kept, the others are removed
+    void build(entt::registry& registry);
+
+    /// @brief Places vehicles at rest on empty edge lanes until there are `count` vehicles
+    void spawnVehicles(std::size_t count);
+
+    void update(float dt);
+
+    /// @brief Writes the transformation of every vehicle
+    void getTransforms(std::vector<glm::mat4>& transforms) const;
+
+    inline std::size_t getVehiclesCount() const {
+        return vehiclesCount;
+    }
+};
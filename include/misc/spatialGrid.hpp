@@ -0,0 +1,82 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "misc/configuration.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+/// @brief Entity or instance of an instanced mesh that occupies a grid cell
+struct GridItem {
+    entt::entity entity = entt::null;
+    /// @brief Name of the instanced mesh of the entity. Empty if the item is the entity itself
+    std::string instances;
+    /// @brief Index of the instance in the instanced mesh
+    unsigned int instance = 0;
+
+    inline bool isInstance() const {
+        return !instances.empty();
+    }
+
+    inline bool operator==(const GridItem& other) const = default;
+};
+
+/// @brief Maps the grid cells of every chunk to the items in them, so that cell queries only visit the items of the cell.
+/// The items have to be inserted and removed by their owners
+class SpatialGrid {
+  private:
+    using Cell = std::vector<GridItem>;
+
+    /// @brief Cells of the chunks in row major order
+    std::unordered_map<glm::ivec2, std::vector<Cell>> chunks;
+
+    Cell* findCell(const glm::ivec2& cell);
+    const Cell* findCell(const glm::ivec2& cell) const;
+
+  public:
+    /// @param cell Position of the cell in normalized world grid coordinates
+    void insert(const glm::ivec2& cell, const GridItem& item);
+
+    /// @brief Removes the item from the cell
+    /// @return True if the item was found
+    bool remove(const glm::ivec2& cell, const GridItem& item);
+
+    /// @brief Replaces the item in the cell, for example if an instance was moved to another index
+    void replace(const glm::ivec2& cell, const GridItem& item, const GridItem& newItem);
+
+    /// @brief Returns the items in the cell
+    const std::vector<GridItem>& query(const glm::ivec2& cell) const;
+
+    /// @brief Removes all items from the cell and returns them
+    std::vector<GridItem> take(const glm::ivec2& cell);
+
+    /// @brief Determines if any item in the cell satisfies the predicate
+    template<typename TPredicate>
+    inline bool any(const glm::ivec2& cell, TPredicate&& predicate) const {
+        for (const GridItem& item : query(cell)) {
+            if (predicate(item)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
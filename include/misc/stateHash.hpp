@@ -0,0 +1,158 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/// @brief Hashes the state of components value by value, so that padding bytes are ignored and the contents of containers are included.
+/// Classes take part by declaring `void hashState(StateHash& hash) const`
+class StateHash {
+    std::uint64_t value = 14695981039346656037ull;
+
+  public:
+    template<typename T>
+    static constexpr bool hasHashState = requires(const T& object, StateHash& hash) { object.hashState(hash); };
+
+    inline std::uint64_t get() const {
+        return value;
+    }
+
+    inline void addBytes(const void* data, std::size_t size) {
+        // FNV-1a
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; i++) {
+            value ^= bytes[i];
+            value *= 1099511628211ull;
+        }
+    }
+
+    template<typename... T>
+    inline void operator()(const T&... values) {
+        (add(values), ...);
+    }
+
+    template<typename T>
+    inline void add(const T& object) {
+        if constexpr (hasHashState<T>) {
+            object.hashState(*this);
+        }
+        else {
+            // pointers are hashed by their address
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>, "the type has to declare hashState");
+            addBytes(&object, sizeof(T));
+        }
+    }
+
+    template<typename T>
+    inline void add(const std::shared_ptr<T>& pointer) {
+        add(pointer.get());
+    }
+
+    // glm types have no padding
+    template<glm::length_t L, typename T, glm::qualifier Q>
+    inline void add(const glm::vec<L, T, Q>& vector) {
+        addBytes(&vector, sizeof(vector));
+    }
+
+    template<glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+    inline void add(const glm::mat<C, R, T, Q>& matrix) {
+        addBytes(&matrix, sizeof(matrix));
+    }
+
+    template<typename T, glm::qualifier Q>
+    inline void add(const glm::qua<T, Q>& quaternion) {
+        addBytes(&quaternion, sizeof(quaternion));
+    }
+
+    template<typename T, std::size_t N>
+    inline void add(const T (&values)[N]) {
+        for (const T& element : values) {
+            add(element);
+        }
+    }
+
+    template<typename T, std::size_t N>
+    inline void add(const std::array<T, N>& values) {
+        for (const T& element : values) {
+            add(element);
+        }
+    }
+
+    template<typename T1, typename T2>
+    inline void add(const std::pair<T1, T2>& pair) {
+        add(pair.first);
+        add(pair.second);
+    }
+
+    inline void add(const std::string& string) {
+        add(string.size());
+        addBytes(string.data(), string.size());
+    }
+
+    template<typename T>
+    inline void add(const std::vector<T>& values) {
+        add(values.size());
+        for (const T& element : values) {
+            add(element);
+        }
+    }
+
+    template<typename K, typename V>
+    inline void add(const std::map<K, V>& values) {
+        add(values.size());
+        for (const auto& entry : values) {
+            add(entry);
+        }
+    }
+
+    template<typename K, typename V>
+    inline void add(const std::unordered_map<K, V>& values) {
+        addUnordered(values);
+    }
+
+    template<typename T>
+    inline void add(const std::unordered_set<T>& values) {
+        addUnordered(values);
+    }
+
+  private:
+    /// @brief The entries are combined independent of their order, which changes when the container is rehashed
+    template<typename T>
+    inline void addUnordered(const T& values) {
+        std::uint64_t sum = 0;
+        for (const auto& entry : values) {
+            StateHash hash;
+            hash.add(entry);
+            sum += hash.get();
+        }
+
+        add(values.size());
+        add(sum);
+    }
+};
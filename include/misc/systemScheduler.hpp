@@ -0,0 +1,185 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "misc/jobSystem.hpp"
+#include "misc/stateHash.hpp"
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_set>
+#include <vector>
+
+class System;
+
+/// @brief A component type that is accessed by a system
+struct ComponentType {
+    entt::id_type id;
+    std::string_view name;
+    /// @brief Creates the storage of the component, so that it is not created concurrently by the systems
+    void (*assure)(entt::registry& registry);
+    /// @brief Hashes the entities and the state of the components. Used to detect undeclared writes.
+    /// Is `nullptr` for components that do not declare `hashState`, so they are not validated
+    std::uint64_t (*hash)(entt::registry& registry);
+
+    template<typename T>
+    static std::uint64_t hashStorage(entt::registry& registry) {
+        StateHash hash;
+
+        if constexpr (std::is_empty_v<T>) {
+            for (const auto [entity] : registry.storage<T>().each()) {
+                hash(entity);
+            }
+        }
+        else {
+            for (const auto& [entity, component] : registry.storage<T>().each()) {
+                hash(entity, component);
+            }
+        }
+
+        return hash.get();
+    }
+
+    template<typename T>
+    static ComponentType get() {
+        ComponentType type{
+            entt::type_hash<T>::value(),
+            entt::type_name<T>::value(),
+            [](entt::registry& registry) { registry.storage<T>(); },
+            nullptr};
+
+        if constexpr (std::is_empty_v<T> || StateHash::hasHashState<T>) {
+            type.hash = &hashStorage<T>;
+        }
+
+        return type;
+    }
+};
+
+/// @brief Declares the components a system reads and writes and how it is ordered relative to other systems.
+/// The access includes the event handlers that are triggered by the system
+struct SystemAccess {
+    std::vector<ComponentType> reads;
+    std::vector<ComponentType> writes;
+    /// @brief Systems of these types that are scheduled before have to be finished first
+    std::vector<std::type_index> after;
+    /// @brief The system uses OpenGL or the window, so it runs on the main thread
+    bool mainThread = false;
+    /// @brief The system creates or destroys entities, so no other system can run at the same time
+    bool structural = false;
+
+    template<typename... T>
+    inline SystemAccess& read() {
+        (reads.push_back(ComponentType::get<T>()), ...);
+        return *this;
+    }
+
+    template<typename... T>
+    inline SystemAccess& write() {
+        (writes.push_back(ComponentType::get<T>()), ...);
+        return *this;
+    }
+
+    template<typename T>
+    inline SystemAccess& runAfter() {
+        after.emplace_back(typeid(T));
+        return *this;
+    }
+
+    bool writesComponent(entt::id_type id) const;
+    bool accessesComponent(entt::id_type id) const;
+
+    /// @brief Checks if the systems can not run at the same time
+    bool conflicts(const SystemAccess& other) const;
+};
+
+/// @brief Runs the systems of a frame as a dependency graph. Systems that do not conflict run concurrently on the job system,
+/// systems that use OpenGL run on the calling thread
+class SystemScheduler {
+  public:
+    using NodeId = std::size_t;
+
+  private:
+    struct Node {
+        std::string name;
+        SystemAccess access;
+        /// @brief Type of the system, used for the ordering constraints
+        std::type_index type;
+        std::function<void()> function;
+
+        std::vector<NodeId> successors;
+        unsigned int dependencies = 0;
+        std::atomic<unsigned int> remaining = 0;
+
+        inline Node(const std::string& name, const SystemAccess& access, std::type_index type, std::function<void()>&& function)
+            : name(name), access(access), type(type), function(std::move(function)) {
+        }
+    };
+
+    entt::registry& registry;
+
+    std::deque<Node> nodes;
+    std::vector<std::pair<NodeId, NodeId>> orderings;
+
+    std::mutex readyMutex;
+    /// @brief Nodes that are ready to run on the main thread
+    std::deque<NodeId> readyNodes;
+    std::atomic<std::size_t> finishedNodes = 0;
+    JobCounter workerJobs;
+
+    bool validation = false;
+    /// @brief All component types that are declared by the scheduled nodes
+    std::vector<ComponentType> componentTypes;
+    /// @brief Component types that were reported as not validated
+    std::unordered_set<entt::id_type> uncheckedTypes;
+
+    void buildGraph();
+
+    void makeReady(NodeId id);
+    void execute(NodeId id);
+
+    /// @brief Runs the nodes one after another and reports components that are changed without declared write access
+    void runValidated();
+
+  public:
+    SystemScheduler(entt::registry& registry);
+
+    /// @brief Schedules the update of a system with its declared access
+    NodeId add(System* system, float dt);
+
+    /// @brief Schedules a function with the given access
+    NodeId add(const std::string& name, const SystemAccess& access, std::function<void()> function);
+
+    /// @brief Makes the second node wait for the first one. The first node has to be added before the second one
+    void precede(NodeId first, NodeId second);
+
+    /// @brief In validation mode the nodes run one after another and undeclared writes are reported. Only components that declare `hashState` are checked
+    inline void setValidation(bool validation) {
+        this->validation = validation;
+    }
+
+    /// @brief Runs all scheduled nodes and removes them afterwards
+    void run();
+};
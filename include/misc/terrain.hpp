@@ -14,6 +14,9 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #pragma once
+#include "misc/configuration.hpp"
+#include "misc/spatialGrid.hpp"
+
 #include <unordered_map>
 
 #include <entt/entt.hpp>
@@ -46,6 +49,12 @@ class Terrain {
 
     std::unordered_map<glm::ivec2, entt::entity> chunkEntities;
 
+    /// @brief Buildings and environment instances per cell
+    SpatialGrid grid;
+
+    /// @brief Seed of the terrain generation. Chunks with the same seed and position are always generated the same way
+    unsigned int seed = Configuration::worldSeed;
+
     /// @brief Returns the terrain height of the cell at the specified position
     /// @param position The position in normalized world grid coords
     /// @return The terrain height at the specified position
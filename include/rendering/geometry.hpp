@@ -19,6 +19,7 @@
 #include "misc/typedefs.hpp"
 
 #include <GL/glew.h>
+#include <memory>
 
 struct VertexAttribute {
     int size;
@@ -54,17 +55,30 @@ class MeshGeometry : public Geometry {
   private:
     bool culling = true;
 
+    /// @brief Copy of the vertex data, only kept if requested on construction
+    std::shared_ptr<const GeometryData> data;
+
   public:
     const static VertexAttributes meshVertexAttributes;
 
     MeshGeometry();
-    MeshGeometry(const GeometryData& data, unsigned int usage = GL_STATIC_DRAW);
+    MeshGeometry(const GeometryData& data, unsigned int usage = GL_STATIC_DRAW, bool retainData = false);
 
     void bufferData(const GeometryData& data, unsigned int usage = GL_STATIC_DRAW);
     void bufferSubData(const std::vector<Vertex>& vertices, unsigned int offset);
     void draw() const override;
 
     void drawInstanced(unsigned int instancesCount) const;
+
+    /// @brief Returns the retained vertex data or `nullptr` if the data was not retained
+    inline const std::shared_ptr<const GeometryData>& getData() const {
+        return data;
+    }
+
+    /// @brief Frees the retained vertex data. Batches that already hold the data keep it alive
+    inline void releaseData() {
+        data.reset();
+    }
 };
 
 using GeometryPtr = ResourcePtr<Geometry>;
@@ -0,0 +1,136 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <glm/glm.hpp>
+
+#include <array>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/// @brief Identifies a rasterized glyph
+struct GlyphKey {
+    unsigned int font;
+    char32_t codepoint;
+    /// @brief The pixel size the glyph is rasterized with
+    unsigned int pixelSize;
+
+    inline bool operator==(const GlyphKey& other) const {
+        return font == other.font && codepoint == other.codepoint && pixelSize == other.pixelSize;
+    }
+};
+
+template<>
+struct std::hash<GlyphKey> {
+    inline size_t operator()(const GlyphKey& key) const {
+        return std::hash<char32_t>()(key.codepoint) ^ (std::hash<unsigned int>()(key.font) << 1) ^ (std::hash<unsigned int>()(key.pixelSize) << 8);
+    }
+};
+
+/// @brief Rasterizes glyphs on demand on a worker thread and packs them into the pages of an atlas texture array. If the atlas is full, the least recently used page is cleared
+class GlyphCache {
+  public:
+    /// @brief Size of one atlas page in pixels
+    static constexpr int pageSize = 512;
+    /// @brief Maximum number of atlas pages, which bounds the memory of the atlas
+    static constexpr int maxPages = 4;
+    /// @brief Empty pixels between the glyphs, so that linear filtering does not bleed into neighbouring glyphs
+    static constexpr int padding = 2;
+    /// @brief Pixel sizes the glyphs are rasterized with. Text is rendered with the next larger size and scaled down
+    static constexpr std::array<unsigned int, 8> pixelSizes = {12, 16, 24, 32, 48, 64, 96, 128};
+
+    struct Glyph {
+        glm::ivec2 size;
+        glm::ivec2 bearing;
+        /// @brief Horizontal advance in pixels
+        int advance;
+
+        /// @brief The atlas page (texture array layer) that contains the glyph
+        int page;
+        /// @brief Texture coordinates of the glyph in the atlas page
+        glm::vec2 uvMin, uvMax;
+    };
+
+  protected:
+    struct GlyphBitmap {
+        GlyphKey key;
+        glm::ivec2 size;
+        glm::ivec2 bearing;
+        int advance;
+        std::vector<unsigned char> pixels;
+    };
+
+    struct Page {
+        glm::ivec2 cursor = glm::ivec2(padding);
+        int rowHeight = 0;
+        unsigned int lastUsed = 0;
+    };
+
+    unsigned int texture = 0;
+    std::vector<Page> pages;
+
+    std::unordered_map<GlyphKey, Glyph> glyphs;
+
+    /// @brief Glyphs that were requested but are not rasterized yet
+    std::vector<GlyphKey> requests;
+    std::unordered_set<GlyphKey> pendingGlyphs;
+    std::future<std::vector<GlyphBitmap>> rasterizationTask;
+
+    /// @brief FreeType objects that are only used by the rasterization task. At most one task runs at a time
+    FT_Library library = nullptr;
+    std::vector<FT_Face> faces;
+
+    unsigned int frame = 0;
+    /// @brief Incremented every time glyphs are added or removed
+    unsigned int generation = 0;
+
+    static std::vector<GlyphBitmap> rasterizeGlyphs(const std::vector<GlyphKey>& keys, const std::vector<FT_Face>& faces);
+
+    void addGlyph(const GlyphBitmap& bitmap);
+    int allocate(const glm::ivec2& size, glm::ivec2& position);
+    void clearPage(int page);
+
+  public:
+    GlyphCache();
+    ~GlyphCache();
+
+    /// @brief Loads a font file
+    /// @return The id of the font
+    unsigned int loadFont(const std::string& filename);
+
+    /// @brief Returns the cached glyph. If the glyph is not cached yet it is requested and `nullptr` is returned
+    const Glyph* getGlyph(const GlyphKey& key);
+
+    /// @brief Marks the pages as used in the current frame
+    /// @param pageMask Bit mask of the used pages
+    void usePages(unsigned int pageMask);
+
+    /// @brief Adds the glyphs that were rasterized since the last update to the atlas and starts the rasterization of new requests
+    void update();
+
+    /// @brief Returns `true` if requested glyphs are not in the atlas yet, so further updates are needed to show them
+    bool hasPendingGlyphs() const;
+
+    /// @brief Returns the smallest pixel size that is at least as large as the text size
+    static unsigned int getPixelSize(int textSize);
+
+    unsigned int getTexture() const;
+    unsigned int getGeneration() const;
+};
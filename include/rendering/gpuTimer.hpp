@@ -0,0 +1,71 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "rendering/renderPass.hpp"
+
+#include <cstdint>
+
+/// @brief Measures the gpu time of the render passes with timestamp queries. The results are read back some frames later, so that the cpu does not wait for the gpu
+class GpuTimer {
+  public:
+    static constexpr int passesCount = renderPassesCount;
+    /// @brief Number of frames whose queries are in flight
+    static constexpr int latency = 4;
+
+  private:
+    bool supported;
+
+    unsigned int queries[latency][passesCount][2];
+    bool issued[latency][passesCount] = {};
+    int frame = 0;
+
+    /// @brief Last measured gpu times in milliseconds
+    float times[passesCount] = {};
+    /// @brief The pass was rendered and its result was available when it was read back
+    bool valid[passesCount] = {};
+
+    /// @brief Difference between the profiler clock and the gpu clock in nanoseconds
+    int64_t clockOffset = 0;
+
+    void resolve(int slot);
+
+  public:
+    GpuTimer();
+    ~GpuTimer();
+
+    /// @brief Reads back the queries of the oldest frame and starts a new frame
+    void beginFrame();
+
+    void begin(RenderPass pass);
+    void end(RenderPass pass);
+
+    /// @brief Gpu time of the pass in milliseconds, measured `latency` frames ago. Is zero if the time is not valid
+    inline float getTime(RenderPass pass) const {
+        return times[static_cast<int>(pass)];
+    }
+
+    /// @brief Checks if the pass has a gpu time for the frame that was read back last
+    inline bool isValid(RenderPass pass) const {
+        return valid[static_cast<int>(pass)];
+    }
+
+    inline bool isSupported() const {
+        return supported;
+    }
+
+    static const char* getPassName(RenderPass pass);
+};
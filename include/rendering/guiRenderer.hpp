@@ -0,0 +1,93 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "gui/rectangle.hpp"
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class ShaderProgram;
+class Texture;
+
+/// @brief Collects the quads of the whole gui in one vertex stream and draws them with as few draw calls as possible
+class GuiRenderer {
+  public:
+    enum class QuadType {
+        COLOR,
+        TEXT,
+        TEXTURE
+    };
+
+  protected:
+    struct GuiVertex {
+        glm::vec2 position;
+        glm::vec2 texCoord;
+        glm::vec4 color;
+        /// @brief Area of the widget, used for the rounded corners
+        glm::vec4 area;
+        float cornerRadius;
+        float type;
+        /// @brief Layer of the glyph atlas
+        float layer;
+    };
+
+    unsigned int vao, vbo;
+    /// @brief Size of the vertex buffer storage in bytes
+    unsigned int capacity = 0;
+
+    ShaderProgram* shader;
+
+    std::vector<GuiVertex> vertices;
+
+    unsigned int glyphAtlas = 0;
+    const Texture* currentTexture = nullptr;
+
+    unsigned int drawCalls = 0;
+
+    void addQuad(const Rectangle& area, const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& color, const Rectangle& widgetArea, float cornerRadius, QuadType type, float layer = 0.0f);
+
+  public:
+    GuiRenderer();
+    ~GuiRenderer();
+
+    /// @brief Starts a new frame
+    /// @param width Width of the screen
+    /// @param height Height of the screen
+    void begin(float width, float height);
+
+    /// @brief Draws all quads that were added since the last flush
+    void flush();
+
+    /// @brief Flushes the remaining quads and restores the render state
+    void end();
+
+    /// @brief Sets the texture that contains the glyphs of all characters
+    void setGlyphAtlas(unsigned int texture);
+
+    void drawRect(const Rectangle& area, const glm::vec4& color, float cornerRadius = 0.0f);
+
+    /// @brief Draws a textured quad. Quads with different textures can not be drawn in the same draw call
+    void drawTexture(const Rectangle& area, const Texture* texture);
+
+    /// @brief Draws a glyph from the glyph atlas
+    /// @param uvMin Texture coordinates of the top left corner in the atlas
+    /// @param uvMax Texture coordinates of the bottom right corner in the atlas
+    void drawGlyph(const Rectangle& area, const glm::vec2& uvMin, const glm::vec2& uvMax, int layer, const glm::vec4& color);
+
+    /// @brief Returns the number of draw calls of the last frame
+    unsigned int getDrawCalls() const;
+};
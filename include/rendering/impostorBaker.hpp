@@ -0,0 +1,32 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "resources/mesh.hpp"
+
+class ShaderProgram;
+
+/// @brief Creates camera facing impostors for meshes
+class ImpostorBaker {
+  public:
+    /// @brief Renders every object of the mesh from several directions around the y axis into a texture atlas and creates quads that display the atlas
+    /// @param mesh The mesh to bake. The bounding spheres must be calculated
+    /// @param impostorShader The shader used to render the impostors
+    /// @param bakeShader The shader used to render the mesh into the atlas
+    /// @param resolution Width and height of one atlas frame in pixels
+    /// @param frames Number of directions
+    /// @return A mesh with one impostor quad per object
+    static MeshPtr bake(const Mesh<>& mesh, ShaderPtr impostorShader, ShaderProgram* bakeShader, unsigned int resolution, unsigned int frames);
+};
@@ -14,6 +14,9 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #pragma once
+#include "misc/stateHash.hpp"
+#include "rendering/renderStats.hpp"
+
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
@@ -24,7 +27,9 @@ struct TransformationComponent;
 class InstanceBuffer {
   private:
     unsigned int vbo;
-    unsigned int instancesCount;
+    unsigned int instancesCount = 0;
+    /// @brief Size of the buffer storage in bytes, only used for streamed buffers
+    unsigned int capacity = 0;
 
   public:
     InstanceBuffer();
@@ -34,7 +39,41 @@ class InstanceBuffer {
         instancesCount = offsets.size();
 
         glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, instancesCount * sizeof(TData), offsets.data(), GL_DYNAMIC_DRAW);
+        counted::bufferData(GL_ARRAY_BUFFER, instancesCount * sizeof(TData), offsets.data(), GL_DYNAMIC_DRAW);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    /// @brief Uploads data that changes every frame. The storage is orphaned and only reallocated if it is too small
+    template<typename TData>
+    inline void streamBuffer(const std::vector<TData>& data) {
+        instancesCount = data.size();
+        const unsigned int size = instancesCount * sizeof(TData);
+
+        if (size > capacity) {
+            capacity = glm::max(size, 2 * capacity);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        counted::bufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+
+        if (size > 0) {
+            counted::bufferSubData(GL_ARRAY_BUFFER, 0, size, data.data());
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    /// @brief Uploads a range of instances after they were changed or removed. The storage is not reallocated, so the data must not grow
+    template<typename TData>
+    inline void updateBuffer(const std::vector<TData>& data, unsigned int first, unsigned int count) {
+        instancesCount = data.size();
+        if (count == 0) {
+            return;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        counted::bufferSubData(GL_ARRAY_BUFFER, first * sizeof(TData), count * sizeof(TData), data.data() + first);
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
@@ -43,4 +82,8 @@ class InstanceBuffer {
 
     unsigned int getVBO() const;
     unsigned int getInstancesCount() const;
+
+    inline void hashState(StateHash& hash) const {
+        hash(vbo, instancesCount, capacity);
+    }
 };
@@ -14,14 +14,18 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #pragma once
+#include "misc/stateHash.hpp"
 #include "rendering/instanceBuffer.hpp"
 
+#include <cstddef>
 #include <vector>
 
 template<typename TData>
 struct InstancedMesh {
     std::vector<TData> transformations;
     InstanceBuffer instanceBuffer;
+    /// @brief Has to be set if the transformations were replaced off the main thread. The render system streams them to the gpu
+    bool bufferOutdated = false;
 
     inline InstancedMesh() {
     }
@@ -34,4 +38,17 @@ struct InstancedMesh {
         : transformations(transformations) {
         instanceBuffer.fillBuffer(transformations);
     }
+
+    /// @brief Removes the instance by moving the last instance into its slot. Only this slot is uploaded again
+    inline void removeInstance(std::size_t index) {
+        transformations[index] = transformations.back();
+        transformations.pop_back();
+
+        const bool moved = index < transformations.size();
+        instanceBuffer.updateBuffer(transformations, index, moved ? 1 : 0);
+    }
+
+    inline void hashState(StateHash& hash) const {
+        hash(transformations, instanceBuffer, bufferOutdated);
+    }
 };
@@ -0,0 +1,28 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+enum class RenderPass {
+    SHADOW,
+    SCENE,
+    /// @brief Debug views that replace the scene, e.g. the shadow maps
+    DEBUG,
+    GUI,
+    /// @brief Work outside of the passes, e.g. uploads while the frame is recorded
+    OTHER
+};
+
+static constexpr int renderPassesCount = 5;
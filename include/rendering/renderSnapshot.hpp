@@ -0,0 +1,90 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "misc/configuration.hpp"
+#include "rendering/meshRenderData.hpp"
+#include "resources/mesh.hpp"
+#include "resources/roadPack.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+class Geometry;
+class InstanceBuffer;
+
+/// @brief A draw call recorded from the registry. The referenced meshes and buffers have to stay alive until the snapshot is submitted
+struct DrawPacket {
+    enum class Type {
+        MESH,
+        INSTANCED,
+        OBJECT_INSTANCED,
+        ROAD_INSTANCED,
+#if DEBUG
+        ROAD_DEBUG,
+#endif
+    };
+
+    Type type;
+    MeshRenderData renderData;
+
+    /// @brief The mesh of the selected detail level
+    const Mesh<>* mesh = nullptr;
+    const std::string* object = nullptr;
+
+    const Mesh<RoadTileTypes>* roadMesh = nullptr;
+    RoadTileTypes tileType;
+
+    const InstanceBuffer* instances = nullptr;
+
+#if DEBUG
+    const Geometry* debugGeometry = nullptr;
+#endif
+};
+
+/// @brief Everything that is needed to submit a frame, recorded from the registry. Submitting the snapshot does not access the registry, so the simulation can change it in the meantime
+struct RenderSnapshot {
+    glm::mat4 viewMatrix;
+    glm::mat4 projectionMatrix;
+    glm::vec3 cameraPosition;
+    glm::vec3 cameraTarget;
+    unsigned int width, height;
+
+    std::array<glm::mat4, Configuration::SHADOW_CASCADE_COUNT> lightView;
+    std::array<glm::mat4, Configuration::SHADOW_CASCADE_COUNT> lightProjection;
+    std::array<float, Configuration::SHADOW_CASCADE_COUNT> cascadeFarPlanes;
+    glm::vec3 lightDirection;
+    glm::vec3 lightAmbient;
+    glm::vec3 lightDiffuse;
+    glm::vec3 lightSpecular;
+
+    /// @brief Draw calls of the camera pass. The vectors keep their capacity from frame to frame
+    std::vector<DrawPacket> cameraPackets;
+    /// @brief Draw calls of the shadow pass
+    std::vector<DrawPacket> shadowPackets;
+
+#if DEBUG
+    bool showShadowMaps = false;
+#endif
+
+    inline void clear() {
+        cameraPackets.clear();
+        shadowPackets.clear();
+    }
+};
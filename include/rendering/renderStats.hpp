@@ -0,0 +1,204 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "rendering/renderPass.hpp"
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/// @brief The component type whose draw packets caused the gl calls
+enum class RenderCategory {
+    MESH,
+    INSTANCED_MESH,
+    MULTI_INSTANCED_MESH,
+    ROAD_MESH,
+    OTHER
+};
+
+struct RenderCounters {
+    unsigned int drawCalls = 0;
+    unsigned int instances = 0;
+    uint64_t triangles = 0;
+    unsigned int programSwitches = 0;
+    unsigned int textureBinds = 0;
+    unsigned int uniformSets = 0;
+    unsigned int vaoBinds = 0;
+    /// @brief Bytes uploaded to buffers
+    uint64_t uploadBytes = 0;
+
+    RenderCounters& operator+=(const RenderCounters& other);
+    bool operator==(const RenderCounters& other) const = default;
+
+    inline bool empty() const {
+        return *this == RenderCounters{};
+    }
+};
+
+/// @brief Counts the gl calls of each frame per render pass and component type
+class RenderStats {
+  public:
+    static constexpr int categoriesCount = 5;
+
+  private:
+    RenderPass pass = RenderPass::OTHER;
+    RenderCategory category = RenderCategory::OTHER;
+
+    RenderCounters counters[renderPassesCount][categoriesCount];
+    /// @brief Counters of the last finished frame
+    RenderCounters lastFrame[renderPassesCount][categoriesCount];
+    unsigned long frame = 0;
+
+    std::ofstream csvStream;
+
+    inline RenderCounters& current() {
+        return counters[static_cast<int>(pass)][static_cast<int>(category)];
+    }
+
+  public:
+    static RenderStats& get();
+
+    /// @brief Writes one line per pass and component type of every frame into the file
+    bool openCsv(const std::string& filename);
+
+    /// @brief Finishes the counters of the last frame and starts a new frame
+    void beginFrame();
+
+    inline void setPass(RenderPass pass) {
+        this->pass = pass;
+    }
+
+    inline void setCategory(RenderCategory category) {
+        this->category = category;
+    }
+
+    void countDraw(GLenum mode, unsigned int count, unsigned int instances);
+
+    inline void countProgramSwitch() {
+        current().programSwitches++;
+    }
+
+    inline void countTextureBind() {
+        current().textureBinds++;
+    }
+
+    inline void countUniformSet() {
+        current().uniformSets++;
+    }
+
+    inline void countVaoBind() {
+        current().vaoBinds++;
+    }
+
+    inline void countUpload(uint64_t bytes) {
+        current().uploadBytes += bytes;
+    }
+
+    RenderCounters getPassCounters(RenderPass pass) const;
+    RenderCounters getCategoryCounters(RenderCategory category) const;
+
+    static const char* getPassName(RenderPass pass);
+    static const char* getCategoryName(RenderCategory category);
+};
+
+/// @brief Wrappers of the gl calls of the renderer, that are counted in the render statistics
+namespace counted {
+    inline void useProgram(GLuint program) {
+        RenderStats::get().countProgramSwitch();
+        glUseProgram(program);
+    }
+
+    inline void bindVertexArray(GLuint vao) {
+        // unbinding is not counted
+        if (vao != 0) {
+            RenderStats::get().countVaoBind();
+        }
+        glBindVertexArray(vao);
+    }
+
+    inline void bindTexture(GLenum target, GLuint texture) {
+        if (texture != 0) {
+            RenderStats::get().countTextureBind();
+        }
+        glBindTexture(target, texture);
+    }
+
+    inline void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        // orphaning the storage does not upload anything
+        if (data != nullptr) {
+            RenderStats::get().countUpload(size);
+        }
+        glBufferData(target, size, data, usage);
+    }
+
+    inline void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        RenderStats::get().countUpload(size);
+        glBufferSubData(target, offset, size, data);
+    }
+
+    inline void drawArrays(GLenum mode, GLint first, GLsizei count) {
+        RenderStats::get().countDraw(mode, count, 1);
+        glDrawArrays(mode, first, count);
+    }
+
+    inline void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+        RenderStats::get().countDraw(mode, count, 1);
+        glDrawElements(mode, count, type, indices);
+    }
+
+    inline void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances) {
+        RenderStats::get().countDraw(mode, count, instances);
+        glDrawElementsInstanced(mode, count, type, indices, instances);
+    }
+
+    inline void uniform1i(GLint location, GLint value) {
+        RenderStats::get().countUniformSet();
+        glUniform1i(location, value);
+    }
+
+    inline void uniform1f(GLint location, GLfloat value) {
+        RenderStats::get().countUniformSet();
+        glUniform1f(location, value);
+    }
+
+    inline void uniform2f(GLint location, GLfloat x, GLfloat y) {
+        RenderStats::get().countUniformSet();
+        glUniform2f(location, x, y);
+    }
+
+    inline void uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z) {
+        RenderStats::get().countUniformSet();
+        glUniform3f(location, x, y, z);
+    }
+
+    inline void uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+        RenderStats::get().countUniformSet();
+        glUniform4f(location, x, y, z, w);
+    }
+
+    inline void uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        RenderStats::get().countUniformSet();
+        glUniformMatrix3fv(location, count, transpose, value);
+    }
+
+    inline void uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        RenderStats::get().countUniformSet();
+        glUniformMatrix4fv(location, count, transpose, value);
+    }
+}
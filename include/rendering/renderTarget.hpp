@@ -0,0 +1,42 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/// @brief Framebuffer with a color and depth attachment that is used instead of the window framebuffer
+class RenderTarget {
+  private:
+    unsigned int fbo;
+    unsigned int colorBuffer;
+    unsigned int depthBuffer;
+
+    int width, height;
+
+  public:
+    RenderTarget(int width, int height);
+    ~RenderTarget();
+
+    inline unsigned int getFramebuffer() const {
+        return fbo;
+    }
+
+    inline int getWidth() const {
+        return width;
+    }
+
+    inline int getHeight() const {
+        return height;
+    }
+};
@@ -16,14 +16,18 @@
 #pragma once
 #include "gui/colors.hpp"
 #include "gui/rectangle.hpp"
-#include "renderQuad.hpp"
-#include "shader.hpp"
+#include "glyphCache.hpp"
+#include "guiRenderer.hpp"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <glm/glm.hpp>
 
-#include <map>
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 enum class TextAlign {
     BEGIN,
@@ -31,32 +35,98 @@ enum class TextAlign {
     END
 };
 
+/// @brief Positioned glyphs of a text at one text size
+struct TextLayout {
+    struct Glyph {
+        /// @brief Position of the top left corner relative to the start of the baseline
+        glm::vec2 offset;
+        glm::vec2 size;
+        glm::vec2 uvMin, uvMax;
+        /// @brief The glyph cache page that contains the glyph
+        int page;
+    };
+
+    std::vector<Glyph> glyphs;
+
+    int textSize;
+    float width, height, baselineOffset;
+
+    /// @brief Bit mask of the glyph cache pages used by the glyphs
+    unsigned int pages = 0;
+    /// @brief The glyph cache generation the layout was created with. The layout is outdated if the generation changed
+    unsigned int generation;
+};
+
+using TextLayoutPtr = std::shared_ptr<const TextLayout>;
+
 class TextRenderer {
   private:
-    struct Character {
-        unsigned int textureId;
-        glm::ivec2 size;
-        glm::ivec2 bearing;
-        unsigned int advance;
-    };
+    /// @brief Number of characters in the kerning table
+    static constexpr int charactersCount = 128;
+    /// @brief Number of cached layouts from which on layouts that are not used by any label are removed
+    static constexpr size_t maxCachedLayouts = 256;
+
+    mutable GlyphCache glyphCache;
+    unsigned int font = 0;
 
-    RenderQuad quad;
     float screenWidth, screenHeight;
+    /// @brief Pixel size of the kerning face
     int pixelWidth = 128;
 
-    std::map<char, Character> characters;
+    /// @brief Face that is used for the kerning on the main thread. The glyphs are rasterized by the glyph cache
+    FT_Library library = nullptr;
+    FT_Face face = nullptr;
 
     bool useKerning;
-    std::map<std::pair<char, char>, glm::ivec2> kerning;
+    /// @brief Horizontal kerning of all character pairs, indexed by `first * charactersCount + second`. The rows are loaded when they are used first
+    mutable std::vector<int> kerning;
+    mutable std::array<bool, charactersCount> kerningLoaded = {};
+
+    struct LayoutKey {
+        std::string text;
+        int textSize;
+
+        inline bool operator==(const LayoutKey& other) const {
+            return textSize == other.textSize && text == other.text;
+        }
+    };
+
+    struct LayoutKeyHash {
+        inline size_t operator()(const LayoutKey& key) const {
+            return std::hash<std::string>()(key.text) ^ (std::hash<int>()(key.textSize) << 1);
+        }
+    };
+
+    mutable std::unordered_map<LayoutKey, TextLayoutPtr, LayoutKeyHash> layouts;
+
+    int getKerning(char32_t first, char32_t second) const;
+
+    TextLayoutPtr createLayout(const std::string& text, int textSize) const;
 
   public:
     glm::vec3 textColor = colors::white;
 
+    ~TextRenderer();
+
     void init();
     void setScreenSize(float width, float height);
 
+    /// @brief Uploads the rasterized glyphs. If the glyph cache changed, the cached layouts are removed
+    void update();
+
+    /// @brief Returns `true` while requested glyphs are rasterized
+    bool hasPendingGlyphs() const;
+
+    /// @brief Returns the cached layout of the text or creates it if the text was not laid out yet
+    TextLayoutPtr getLayout(const std::string& text, int textSize) const;
+
     float getWidth(const std::string& text, int textSize) const;
     float getHeight(const std::string& text, int textSize, float* baseLineOffset) const;
 
-    void renderText(const std::string& text, const Rectangle& rect, int textSize, TextAlign align) const;
+    /// @brief Adds the glyphs of the text to the gui renderer
+    void renderText(GuiRenderer& renderer, const TextLayout& layout, const Rectangle& rect, TextAlign align, const glm::vec4& color) const;
+
+    /// @brief Returns the texture array that contains the cached glyphs
+    unsigned int getAtlasTexture() const;
+    unsigned int getGeneration() const;
 };
@@ -29,8 +29,14 @@ class Texture {
     Texture(const std::string& filename, int pixelFormat);
     Texture(const glm::vec3& rgb, int width, int height);
     Texture(const glm::vec4& rgba, int width, int height);
+    /// @brief Creates an empty rgba texture that can be used as render target
+    Texture(int width, int height);
 
     void use(unsigned int texUnit) const;
+
+    void generateMipmaps() const;
+
+    unsigned int getID() const;
 };
 
 using TexturePtr = ResourcePtr<Texture>;
@@ -24,6 +24,7 @@
 #include "misc/typedefs.hpp"
 
 #include <glm/glm.hpp>
+#include <limits>
 #include <vector>
 
 template<typename T>
@@ -99,6 +100,23 @@ struct Mesh {
     ShaderPtr shader;
     std::unordered_map<TKey, std::vector<std::pair<MaterialPtr, GeometryPtr>>> geometries;
 
+    /// @brief Bounding spheres of the objects in model space. The center is stored in xyz and the radius in w
+    std::unordered_map<TKey, glm::vec4> boundingSpheres;
+    /// @brief Bounding sphere of the whole mesh
+    glm::vec4 boundingSphere = glm::vec4(0.0f);
+
+    /// @brief A lower detail version of the mesh
+    struct Lod {
+        ResourcePtr<Mesh<TKey>> mesh;
+        /// @brief The level is used if the projected diameter of the bounding sphere (relative to the screen height) falls below this value
+        float maxScreenSize;
+        /// @brief `true` if the level consists of camera facing impostor quads, which can only be rendered instanced
+        bool impostor = false;
+    };
+
+    /// @brief Lower detail levels ordered from high to low detail
+    std::vector<Lod> lods;
+
     inline Mesh() {
 
     }
@@ -171,6 +189,85 @@ struct Mesh {
         }
     }
 
+    /// @brief Returns the mesh of the given detail level. Level 0 is the mesh itself
+    inline const Mesh<TKey>& getLod(unsigned int level) const {
+        return level == 0 ? *this : *lods[level - 1].mesh;
+    }
+
+    /// @brief Returns the number of detail levels that consist of real geometry, including the mesh itself
+    inline unsigned int getGeometryLodCount() const {
+        unsigned int count = 1;
+        while (count <= lods.size() && !lods[count - 1].impostor) {
+            count++;
+        }
+
+        return count;
+    }
+
+    /// @brief Selects the detail level for the given projected size. The level only changes if the size passes the threshold by more than the hysteresis
+    /// @param screenSize Projected diameter of the bounding sphere relative to the screen height
+    /// @param currentLevel The level that was used in the last frame
+    /// @param hysteresis Relative margin around the thresholds
+    inline unsigned int selectLod(float screenSize, unsigned int currentLevel, float hysteresis) const {
+        unsigned int level = glm::min(currentLevel, static_cast<unsigned int>(lods.size()));
+
+        while (level < lods.size() && screenSize < lods[level].maxScreenSize * (1.0f - hysteresis)) {
+            level++;
+        }
+
+        while (level > 0 && screenSize > lods[level - 1].maxScreenSize * (1.0f + hysteresis)) {
+            level--;
+        }
+
+        return level;
+    }
+
+    /// @brief Frees the retained vertex data of all geometries. Meshes that are never batched only need it while they are loaded
+    inline void releaseData() {
+        for (auto& [key, object] : geometries) {
+            for (auto& [_, geometry] : object) {
+                if (const auto& meshGeometry = std::dynamic_pointer_cast<MeshGeometry>(geometry)) {
+                    meshGeometry->releaseData();
+                }
+            }
+        }
+    }
+
+    /// @brief Calculates the bounding spheres of all objects whose geometry data was retained
+    inline void calculateBoundingSpheres() {
+        boundingSpheres.clear();
+        glm::vec3 meshMin = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 meshMax = glm::vec3(std::numeric_limits<float>::lowest());
+
+        for (const auto& [key, object] : geometries) {
+            glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+            glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+            for (const auto& [_, geometry] : object) {
+                const auto& meshGeometry = std::dynamic_pointer_cast<MeshGeometry>(geometry);
+                if (!meshGeometry || !meshGeometry->getData()) {
+                    continue;
+                }
+
+                for (const Vertex& vertex : meshGeometry->getData()->vertices) {
+                    min = glm::min(min, vertex.position);
+                    max = glm::max(max, vertex.position);
+                }
+            }
+
+            if (min.x <= max.x) {
+                boundingSpheres[key] = glm::vec4(0.5f * (min + max), 0.5f * glm::length(max - min));
+
+                meshMin = glm::min(meshMin, min);
+                meshMax = glm::max(meshMax, max);
+            }
+        }
+
+        if (meshMin.x <= meshMax.x) {
+            boundingSphere = glm::vec4(0.5f * (meshMin + meshMax), 0.5f * glm::length(meshMax - meshMin));
+        }
+    }
+
     template<typename T>
     inline void linkInstanceBuffer(const InstanceBuffer& buffer) const {
         unsigned int vbo = buffer.getVBO();
@@ -0,0 +1,34 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "rendering/geometryData.hpp"
+
+#include <string>
+#include <vector>
+
+/// @brief The faces of one object that use the same material
+struct MeshPart {
+    std::string objectName;
+    std::string materialName;
+    GeometryData dataCulling;
+    GeometryData dataNonCulling;
+};
+
+/// @brief The parsed content of a mesh file before any OpenGL objects are created
+struct MeshData {
+    std::vector<std::string> materialLibs;
+    std::vector<MeshPart> parts;
+};
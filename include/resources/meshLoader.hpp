@@ -17,6 +17,7 @@
 
 #include "rendering/geometryData.hpp"
 #include "resources/mesh.hpp"
+#include "resources/meshData.hpp"
 
 #include <array>
 #include <sstream>
@@ -104,5 +105,11 @@ class MeshLoader {
 
     static std::unordered_map<std::string, MaterialPtr> loadMaterials(const std::string& filename);
 
+    /// @brief Reads and triangulates a mesh file. Does not use OpenGL, so it can run on worker threads
+    static MeshData parseMesh(const std::string& filename);
+
+    /// @brief Loads the materials and uploads the geometry of a parsed mesh
+    static MeshPtr createMesh(const MeshData& data);
+
     static MeshPtr loadMesh(const std::string& filename);
 };
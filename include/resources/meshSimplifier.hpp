@@ -0,0 +1,53 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "rendering/geometryData.hpp"
+#include "resources/mesh.hpp"
+
+/// @brief Creates lower detail versions of meshes by quadric error edge collapses
+class MeshSimplifier {
+  protected:
+    /// @brief Symmetric 4x4 error quadric, only the upper triangle is stored
+    struct Quadric {
+        double values[10] = {};
+
+        static Quadric fromPlane(const glm::dvec4& plane, double weight);
+
+        Quadric& operator+=(const Quadric& other);
+
+        double evaluate(const glm::vec3& position) const;
+    };
+
+    struct Collapse {
+        double cost;
+        unsigned int from, to;
+        unsigned int fromVersion, toVersion;
+
+        inline bool operator>(const Collapse& other) const {
+            return cost > other.cost;
+        }
+    };
+
+  public:
+    /// @brief Reduces the number of triangles by collapsing vertices into their neighbours. Vertices on open borders are never moved
+    /// @param data The geometry to simplify
+    /// @param ratio The fraction of triangles that should remain
+    /// @return The simplified geometry
+    static GeometryData simplify(const GeometryData& data, float ratio);
+
+    /// @brief Simplifies all objects of the mesh. Geometries without retained vertex data are copied unchanged
+    static MeshPtr simplify(const Mesh<>& mesh, float ratio);
+};
@@ -17,6 +17,7 @@
 #include "components/component.hpp"
 #include "misc/typedefs.hpp"
 
+#include <map>
 #include <string>
 #include <typeindex>
 #include <vector>
@@ -24,7 +25,11 @@
 /// @brief This structure is a template for an entity that holds various components.
 struct Object {
   protected:
+    /// @brief Assigns a component to many entities at once
+    using ComponentInserter = void (*)(const AssignableComponent& prototype, entt::registry& registry, const std::vector<entt::entity>& entities);
+
     std::map<std::type_index, std::shared_ptr<AssignableComponent>> components;
+    std::map<std::type_index, ComponentInserter> inserters;
 
   public:
     /// @brief The name of the object
@@ -36,6 +41,21 @@ struct Object {
     template<AssignableComponentType TComponent>
     inline void addComponent(const TComponent& component) {
         components[typeid(TComponent)] = std::make_shared<TComponent>(component);
+
+        inserters[typeid(TComponent)] = [](const AssignableComponent& prototype, entt::registry& registry, const std::vector<entt::entity>& entities) {
+            auto& storage = registry.storage<TComponent>();
+            storage.reserve(storage.size() + entities.size());
+
+            // components that finalize their copies are assigned one by one, so that the batch creates the same components as single entities
+            if constexpr (CopyOnAssign<TComponent>::value) {
+                registry.insert<TComponent>(entities.begin(), entities.end(), static_cast<const TComponent&>(prototype));
+            }
+            else {
+                for (const entt::entity entity : entities) {
+                    prototype.assignToEntity(entity, registry);
+                }
+            }
+        };
     }
 
     /// @brief Creates an entity in the given registry and assings the associated components to this entity.
@@ -50,6 +70,22 @@ struct Object {
 
         return entity;
     }
+
+    /// @brief Creates many entities at once. Every component storage is grown once. Components marked with `CopyOnAssign` are copied into it,
+    /// so their heavy data has to be shared. The others are assigned like for single entities.
+    /// @param registry The registry in which the components will be created
+    /// @param count The number of entities
+    /// @return The created entities
+    inline std::vector<entt::entity> create(entt::registry& registry, std::size_t count) const {
+        std::vector<entt::entity> entities(count);
+        registry.create(entities.begin(), entities.end());
+
+        for (const auto& [type, component] : components) {
+            inserters.at(type)(*component, registry, entities);
+        }
+
+        return entities;
+    }
 };
 
 /// @brief A resource pointer to an object
@@ -17,12 +17,22 @@
 
 #include "misc/typedefs.hpp"
 
+#include "meshData.hpp"
 #include "objectLoader.hpp"
 
+#include <optional>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
 
+namespace pugi {
+    class xml_document;
+    class xml_node;
+}
+
+template<typename TKey>
+struct Mesh;
+
 class ResourceManager {
   private:
     struct ResourceHolder {
@@ -35,6 +45,15 @@ class ResourceManager {
 
     ObjectLoader objectLoader;
 
+    /// @brief Mesh files that were parsed ahead of the resource creation, by file path
+    std::unordered_map<std::string, MeshData> parsedMeshes;
+
+    /// @brief Parses the mesh files referenced by the resource file in parallel
+    void parseMeshes(const pugi::xml_document& doc);
+
+    /// @brief Creates the mesh from the parsed data if available, otherwise the file is loaded
+    ResourcePtr<Mesh<std::string>> loadMesh(const std::string& path);
+
     template<typename T>
     inline void setResource(const std::string& id, ResourcePtr<T> data) {
         ResourcePtr<void> dataPtr = ResourcePtr<T>(data);
@@ -64,6 +83,9 @@ class ResourceManager {
 
     void loadResources();
 
+    /// @brief Creates the detail levels of the mesh that are described by the child nodes of the mesh node
+    void loadMeshLods(Mesh<std::string>& mesh, const pugi::xml_node& node);
+
     template<typename T, typename... TArgs>
     void loadResource(const std::string& resourceId, const std::string& filename, TArgs... args);
 
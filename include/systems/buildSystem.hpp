@@ -90,9 +90,22 @@ class BuildSystem : public System {
     /// @brief Determines if the given building could be build
     /// @param positions The position data of the building
     /// @param type The building type
-    /// @param terrain The terrain information
     /// @return True if the building could be build otherwise false
-    bool canBuild(const std::vector<glm::ivec2>& positions, const BuildingType type, const TerrainComponent& terrain) const;
+    bool canBuild(const std::vector<glm::ivec2>& positions, const BuildingType type) const;
+
+    /// @brief Returns the cells covered by the building
+    static std::vector<glm::ivec2> getFootprint(const BuildingComponent& building);
+
+    /// @brief Adds a placed building to the cells it covers
+    void addToGrid(entt::entity entity, const BuildingComponent& building) const;
+
+    void removeFromGrid(entt::registry& registry, entt::entity entity) const;
+
+    /// @brief Places a car on every spot of a new parking lot. The cars are attached to the lot, so they follow its transformation
+    void parkCars(entt::entity lot);
+
+    /// @brief Destroys the cars that are parked on a parking lot that is destroyed
+    void removeParkedCars(entt::registry& registry, entt::entity lot) const;
 
     static constexpr glm::vec3 getBuildingOffset(const BuildingType type);
 
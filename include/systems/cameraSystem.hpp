@@ -20,6 +20,8 @@
 #include "events/keyEvent.hpp"
 #include "events/mouseEvents.hpp"
 
+#include "misc/cameraPath.hpp"
+
 class CameraSystem : public System {
   protected:
     entt::entity cameraEntity;
@@ -29,12 +31,33 @@ class CameraSystem : public System {
 
     int inputX = 0, inputZ = 0;
 
+    /// @brief Path that is recorded or played back
+    CameraPath path;
+    float pathTime = 0.0f;
+    float recordTimer = 0.0f;
+    bool recording = false;
+    bool playing = false;
+
     virtual void init() override;
 
+    void updatePlayback(float dt);
+    void recordKeyframe();
+
+    void startRecording();
+    void stopRecording();
+
   public:
     CameraSystem(Game* game);
 
     virtual void update(float dt) override;
 
+    /// @brief Moves the camera along the path instead of the keyboard input
+    void playPath(const CameraPath& path);
+
+    inline bool isPlaying() const {
+        return playing;
+    }
+
     void onFramebufferSize(const FramebufferSizeEvent& e);
+    void handleKeyEvent(const KeyEvent& e);
 };
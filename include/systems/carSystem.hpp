@@ -17,24 +17,25 @@
 #include "system.hpp"
 
 #include "events/buildEvent.hpp"
-#include "misc/direction.hpp"
-
-struct CarComponent;
-struct TransformationComponent;
-struct VelocityComponent;
+#include "misc/roads/traffic.hpp"
 
 class CarSystem : public System {
   protected:
-    void init() override;
+    TrafficNetwork traffic;
+    /// @brief Entity whose instanced mesh renders all cars
+    entt::entity trafficEntity;
+    /// @brief Is set if the roads changed, so that the lanes are created again
+    bool networkOutdated = true;
 
-    static void updateCar(CarComponent& carComponent, TransformationComponent& transform, VelocityComponent& velocity);
+    void init() override;
 
   public:
     CarSystem(Game* game);
 
     void update(float dt) override;
 
-    const entt::entity spawnCar(const glm::vec3& position, Direction drivingDirection) const;
+    /// @brief Writes the transformations of all cars into the instanced mesh. Is called once per frame after the simulation steps
+    void updateInstances();
 
     void handleBuildEvent(BuildEvent& e);
 };
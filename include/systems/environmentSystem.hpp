@@ -16,10 +16,18 @@
 #pragma once
 #include "systems/system.hpp"
 
+#include "misc/terrain.hpp"
+
+#include <future>
 #include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 struct BuildEvent;
 struct ChunkCreatedEvent;
+template<typename Event>
+struct EventBatch;
 struct TransformationComponent;
 struct SunLightComponent;
 struct TerrainComponent;
@@ -39,10 +47,24 @@ class EnvironmentSystem : public System {
 
     entt::entity treeEntity;
 
+    using TreeTransforms = std::unordered_map<std::string, std::vector<glm::mat4>>;
+    /// @brief Chunks whose trees are placed on worker threads
+    std::vector<std::pair<entt::entity, std::future<TreeTransforms>>> scatterTasks;
+
+    /// @brief Places the trees on the grass cells of a chunk. Only reads the terrain data of the chunk, so it can run on worker threads
+    static TreeTransforms scatterTrees(const glm::ivec2& chunkPosition, unsigned int seed, float** const heightValues, TerrainSurfaceTypes** const surfaceTypes);
+
+    /// @brief Adds the placed trees to their chunks
+    void finishScatterTasks();
+
     void updateDayNightCycle(float dt, TransformationComponent& sunTransform, SunLightComponent& sunLight) const;
 
     void destroyEntities();
 
+    /// @brief Returns the cell in which the instance of an entity with the given transformation is rendered
+    static glm::ivec2 getInstanceCell(const glm::mat4& transform, const glm::mat4& instance);
+
+    /// @brief Removes the environment instances in the queued cells
     void clearCells();
 
   public:
@@ -52,5 +74,5 @@ class EnvironmentSystem : public System {
 
     void handleBuildEvent(const BuildEvent& e);
 
-    void handleChunkCreatedEvent(const ChunkCreatedEvent& e) const;
+    void handleChunksCreated(const EventBatch<ChunkCreatedEvent>& batch);
 };
@@ -0,0 +1,42 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "system.hpp"
+
+#include <entt/entt.hpp>
+
+/// @brief Calculates the world matrices of attached entities. Only entities whose own or parent matrix changed are updated
+class HierarchySystem : public System {
+  private:
+    /// @brief The depths of the attached entities changed, so the storage is sorted again
+    bool sortRequired = false;
+
+    void onHierarchyChanged(entt::registry& registry, entt::entity entity);
+
+    void sortHierarchy();
+
+  public:
+    HierarchySystem(Game* game);
+
+    void update(float dt) override;
+
+    /// @brief Attaches the entity to the parent. Its position, rotation and scale are relative to the parent afterwards
+    /// @return `false` if the parent is the entity itself or one of its descendants. The hierarchy is not changed in that case
+    static bool setParent(entt::registry& registry, entt::entity entity, entt::entity parent);
+
+    /// @brief Detaches the entity from its parent. It keeps its world transformation
+    static void removeParent(entt::registry& registry, entt::entity entity);
+};
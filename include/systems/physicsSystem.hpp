@@ -16,10 +16,33 @@
 #pragma once
 #include "system.hpp"
 
+#include <array>
+#include <cstddef>
+
+#include <entt/entt.hpp>
+
 class PhysicsSystem : public System {
   private:
+    /// @brief Number of bodies that are integrated by one job
+    static constexpr std::size_t bodiesPerJob = 1024;
+
+    /// @brief Linear movements of a range of bodies packed into separate arrays, so that the integration is vectorized
+    struct Bodies {
+        std::size_t count = 0;
+        std::array<entt::entity, bodiesPerJob> entities;
+        std::array<float, bodiesPerJob> positionX;
+        std::array<float, bodiesPerJob> positionY;
+        std::array<float, bodiesPerJob> positionZ;
+        std::array<float, bodiesPerJob> velocityX;
+        std::array<float, bodiesPerJob> velocityY;
+        std::array<float, bodiesPerJob> velocityZ;
+    };
+
     void init() override;
 
+    /// @brief Moves the packed bodies along their linear velocity
+    static void integrate(Bodies& bodies, float dt);
+
   public:
     PhysicsSystem(Game* game);
 
@@ -18,10 +18,16 @@
 #include "systems/system.hpp"
 
 #include "components/buildingComponent.hpp"
+#include "components/instanceCullingComponent.hpp"
 #include "components/instancedMeshComponent.hpp"
 #include "components/meshComponent.hpp"
 #include "components/roadMeshComponent.hpp"
+#include "components/staticBatchComponent.hpp"
+#include "components/terrainComponent.hpp"
 #include "components/transformationComponent.hpp"
+#include "misc/eventBus.hpp"
+#include "misc/occlusionBuffer.hpp"
+#include "rendering/renderSnapshot.hpp"
 #include "rendering/shadowBuffer.hpp"
 #include "resources/roadPack.hpp"
 
@@ -39,12 +45,16 @@ class RenderSystem : public System {
     unsigned int uboLight;
 
     ShadowBuffer shadowBuffer;
+    OcclusionBuffer occlusionBuffer;
 #if DEBUG
     ShadowMapRenderer shadowMapRenderer;
 #endif
 
     unsigned int cameraWidth;
 
+    /// @brief The recorded frame. It is recorded and submitted in the same frame, so one snapshot is enough
+    RenderSnapshot snapshot;
+
     ShaderPtr shadowShader;
 
     glm::vec4 skyColor = glm::vec4(1.0f, 1.0f, 220.0f / 255.0f, 1.0f);
@@ -52,10 +62,10 @@ class RenderSystem : public System {
     void init() override;
 
     void onCameraUpdated(CameraUpdateEvent& event) const;
-    void onEntityMoved(EntityMoveEvent& event) const;
+    void onEntitiesMoved(const EventBatch<EntityMoveEvent>& batch) const;
 
     template<typename... T>
-    inline void renderScene(entt::exclude_t<T...> exclude = {}) const {
+    inline void recordScene(std::vector<DrawPacket>& packets, entt::exclude_t<T...> exclude = {}) const {
         GameState gameState = game->getState();
 
         registry.view<MeshComponent, TransformationComponent>(exclude)
@@ -72,59 +82,78 @@ class RenderSystem : public System {
                     renderData.preview = building.preview;
                 }
 
-                mesh.mesh->render(renderData);
+                if (isOccluded(entity, mesh.mesh, transform.transform)) {
+                    return;
+                }
+
+                packets.push_back(DrawPacket{DrawPacket::Type::MESH, renderData, &mesh.mesh->getLod(mesh.lod)});
             });
 
         registry.view<InstancedMeshComponent, TransformationComponent>(exclude)
             .each([&](const InstancedMeshComponent& mesh, const TransformationComponent& transform) {
-                MeshRenderData renderData = {transform.transform};
-                mesh.mesh->renderInstanced<TransformationComponent>(renderData, mesh.instanceBuffer);
+                DrawPacket& packet = packets.emplace_back(DrawPacket::Type::INSTANCED, MeshRenderData{transform.transform}, mesh.mesh.get());
+                packet.instances = &mesh.instanceBuffer;
             });
 
         registry.view<MultiInstancedMeshComponent, TransformationComponent>(exclude)
-            .each([&](const MultiInstancedMeshComponent& mesh, const TransformationComponent& transform) {
-                MeshRenderData renderData = {transform.transform};
+            .each([&](auto entity, const MultiInstancedMeshComponent& mesh, const TransformationComponent& transform) {
+                const MeshRenderData renderData = {transform.transform};
+                const InstanceCullingComponent* culling = registry.try_get<InstanceCullingComponent>(entity);
 
                 for (const auto& [name, instances] : mesh.transforms) {
-                    mesh.mesh->renderObjectInstanced<TransformationComponent>(name, renderData, instances.instanceBuffer);
+                    if (culling == nullptr || !culling->instances.contains(name)) {
+                        DrawPacket& packet = packets.emplace_back(DrawPacket::Type::OBJECT_INSTANCED, renderData, mesh.mesh.get(), &name);
+                        packet.instances = &instances.instanceBuffer;
+                        continue;
+                    }
+
+                    const CulledInstances& culled = culling->instances.at(name);
+                    for (unsigned int level = 0; level < culled.cameraInstances.size(); level++) {
+                        if (culled.cameraInstances[level].getInstancesCount() > 0) {
+                            DrawPacket& packet = packets.emplace_back(DrawPacket::Type::OBJECT_INSTANCED, renderData, &mesh.mesh->getLod(level), &name);
+                            packet.instances = &culled.cameraInstances[level];
+                        }
+                    }
                 }
             });
 
-        registry.view<RoadMeshComponent, TransformationComponent>(exclude).each([&](const RoadMeshComponent& road, const TransformationComponent& transform) {
-            MeshRenderData renderData = {transform.transform};
-
-            for (const auto& [typeID, tiles] : road.roadMeshes) {
-                const std::string& roadPackName = getRoadTypeName(typeID);
-                const RoadPackPtr& pack = resourceManager.getResource<RoadPack>(roadPackName);
+        registry.view<StaticBatchComponent, TransformationComponent>(exclude)
+            .each([&](const StaticBatchComponent& batch, const TransformationComponent& transform) {
+                if (!batch.valid) {
+                    return;
+                }
 
-                for (const auto& [tileType, instances] : tiles) {
-                    pack->roadGeometries.renderObjectInstanced<glm::mat4>(tileType, renderData, instances.instanceBuffer);
+                if (occlusionBuffer.isOccluded(glm::vec3(transform.transform * glm::vec4(batch.boundsMin, 1.0f)), glm::vec3(transform.transform * glm::vec4(batch.boundsMax, 1.0f)))) {
+                    return;
                 }
-            }
 
-#if DEBUG
-            if (game->debugMode) {
-                ShaderProgram* roadDebugPointsShader = resourceManager.getResource<Shader>("ROAD_DEBUG_POINTS_SHADER")->defaultShader;
-                ShaderProgram* roadDebugLinesShader = resourceManager.getResource<Shader>("ROAD_DEBUG_LINES_SHADER")->defaultShader;
+                packets.push_back(DrawPacket{DrawPacket::Type::MESH, MeshRenderData{transform.transform}, batch.mesh.get()});
+            });
 
-                roadDebugLinesShader->use();
-                roadDebugLinesShader->setMatrix4("model", transform.transform);
+        registry.view<RoadMeshComponent, TransformationComponent>(exclude).each([&](auto entity, const RoadMeshComponent& road, const TransformationComponent& transform) {
+            const MeshRenderData renderData = {transform.transform};
 
-                road.graphDebugMesh->draw();
+            // roads lie slightly above the terrain of their chunk
+            const TerrainComponent* terrain = registry.try_get<TerrainComponent>(entity);
+            const bool occluded = terrain != nullptr && isChunkOccluded(transform.transform, terrain->minHeight, terrain->maxHeight + 1.0f);
 
-                glEnable(GL_PROGRAM_POINT_SIZE);
-                roadDebugPointsShader->use();
-                roadDebugPointsShader->setMatrix4("model", transform.transform);
+            // roads of batched chunks are part of the static batch
+            const StaticBatchComponent* batch = registry.try_get<StaticBatchComponent>(entity);
+            if (!occluded && (batch == nullptr || !batch->valid || !batch->containsRoads)) {
+                recordRoads(packets, road, renderData);
+            }
 
-                road.graphDebugMesh->draw();
-                glDisable(GL_PROGRAM_POINT_SIZE);
+#if DEBUG
+            if (game->debugMode) {
+                DrawPacket& packet = packets.emplace_back(DrawPacket::Type::ROAD_DEBUG, renderData);
+                packet.debugGeometry = road.graphDebugMesh;
             }
 #endif
         });
     }
 
     template<typename... T>
-    inline void renderSceneShadows(entt::exclude_t<T...> exclude = {}) const {
+    inline void recordSceneShadows(std::vector<DrawPacket>& packets, entt::exclude_t<T...> exclude = {}) const {
         GameState gameState = game->getState();
 
         registry.view<MeshComponent, TransformationComponent>(exclude)
@@ -141,42 +170,99 @@ class RenderSystem : public System {
                     renderData.preview = building.preview;
                 }
 
-                mesh.mesh->render(renderData, shadowShader.get());
+                packets.push_back(DrawPacket{DrawPacket::Type::MESH, renderData, &mesh.mesh->getLod(mesh.lod)});
             });
 
         registry.view<InstancedMeshComponent, TransformationComponent>(exclude)
             .each([&](const InstancedMeshComponent& mesh, const TransformationComponent& transform) {
-                MeshRenderData renderData = {transform.transform};
-                mesh.mesh->renderInstanced<TransformationComponent>(renderData, mesh.instanceBuffer, shadowShader.get());
+                DrawPacket& packet = packets.emplace_back(DrawPacket::Type::INSTANCED, MeshRenderData{transform.transform}, mesh.mesh.get());
+                packet.instances = &mesh.instanceBuffer;
             });
 
         registry.view<MultiInstancedMeshComponent, TransformationComponent>(exclude)
-            .each([&](const MultiInstancedMeshComponent& mesh, const TransformationComponent& transform) {
-                MeshRenderData renderData = {transform.transform};
+            .each([&](auto entity, const MultiInstancedMeshComponent& mesh, const TransformationComponent& transform) {
+                const MeshRenderData renderData = {transform.transform};
+                const InstanceCullingComponent* culling = registry.try_get<InstanceCullingComponent>(entity);
 
                 for (const auto& [name, instances] : mesh.transforms) {
-                    mesh.mesh->renderObjectInstanced<TransformationComponent>(name, renderData, instances.instanceBuffer, shadowShader.get());
+                    if (culling == nullptr || !culling->instances.contains(name)) {
+                        DrawPacket& packet = packets.emplace_back(DrawPacket::Type::OBJECT_INSTANCED, renderData, mesh.mesh.get(), &name);
+                        packet.instances = &instances.instanceBuffer;
+                        continue;
+                    }
+
+                    const CulledInstances& culled = culling->instances.at(name);
+                    for (unsigned int level = 0; level < culled.shadowInstances.size(); level++) {
+                        if (culled.shadowInstances[level].getInstancesCount() > 0) {
+                            DrawPacket& packet = packets.emplace_back(DrawPacket::Type::OBJECT_INSTANCED, renderData, &mesh.mesh->getLod(level), &name);
+                            packet.instances = &culled.shadowInstances[level];
+                        }
+                    }
                 }
             });
 
-        registry.view<RoadMeshComponent, TransformationComponent>(exclude).each([&](const RoadMeshComponent& road, const TransformationComponent& transform) {
-            MeshRenderData renderData = {transform.transform};
+        registry.view<StaticBatchComponent, TransformationComponent>(exclude)
+            .each([&](const StaticBatchComponent& batch, const TransformationComponent& transform) {
+                if (!batch.valid) {
+                    return;
+                }
 
-            for (const auto& [typeID, tiles] : road.roadMeshes) {
-                const std::string& roadPackName = getRoadTypeName(typeID);
-                const RoadPackPtr& pack = resourceManager.getResource<RoadPack>(roadPackName);
+                packets.push_back(DrawPacket{DrawPacket::Type::MESH, MeshRenderData{transform.transform}, batch.mesh.get()});
+            });
 
-                for (const auto& [tileType, instances] : tiles) {
-                    pack->roadGeometries.renderObjectInstanced<glm::mat4>(tileType, renderData, instances.instanceBuffer, shadowShader.get());
-                }
+        registry.view<RoadMeshComponent, TransformationComponent>(exclude).each([&](auto entity, const RoadMeshComponent& road, const TransformationComponent& transform) {
+            // roads of batched chunks are part of the static batch
+            const StaticBatchComponent* batch = registry.try_get<StaticBatchComponent>(entity);
+            if (batch == nullptr || !batch->valid || !batch->containsRoads) {
+                recordRoads(packets, road, MeshRenderData{transform.transform});
             }
         });
     }
 
-    void updateLightBuffer(const LightComponent& sunLight, const CameraComponent& component) const;
+    void recordRoads(std::vector<DrawPacket>& packets, const RoadMeshComponent& road, const MeshRenderData& renderData) const;
+
+    /// @brief Records the draw calls and the camera and light data of the frame
+    void recordSnapshot();
+
+    /// @brief Issues the draw calls of the packets
+    /// @param shader Shader that replaces the shaders of the meshes, used for the shadow pass
+    void submitPackets(const std::vector<DrawPacket>& packets, Shader* shader = nullptr) const;
+
+    void updateCameraBuffer() const;
+    void updateLightBuffer() const;
+
+    /// @brief Streams the instances of instanced meshes whose transformations were replaced by another system
+    void uploadInstances();
+
+    /// @brief Tests the instances of all entities with an `InstanceCullingComponent` against the camera frustum and the shadow cascades and streams the visible instances to the gpu
+    void cullInstances() const;
+
+    /// @brief Rasterizes the visible occluders into the occlusion buffer
+    void renderOcclusionBuffer();
+
+    /// @brief Tests the bounds of a mesh against the occlusion buffer. Terrain chunks use the range of their height values
+    bool isOccluded(entt::entity entity, const MeshPtr& mesh, const glm::mat4& transform) const;
+
+    /// @brief Tests the bounding box of a chunk against the occlusion buffer
+    bool isChunkOccluded(const glm::mat4& transform, float minHeight, float maxHeight) const;
+
+    /// @brief Selects the detail levels of meshes with lower detail versions by their projected size
+    void updateMeshLods() const;
+
+    static void updateInstanceBounds(CulledInstances& culled, const std::vector<glm::mat4>& transformations, const glm::mat4& model, const glm::vec4& boundingSphere);
+
+    /// @brief Shrinks instances at the end of the draw distance so that they do not pop out
+    static glm::mat4 fadeInstance(const glm::mat4& transformation, float distance, float maxDistance);
+
+    /// @brief Returns the diameter of a sphere projected to the screen relative to the screen height
+    static float getScreenSize(const CameraComponent& camera, float radius, float distance);
 
   public:
     RenderSystem(Game* app);
 
+    /// @brief Culls the scene and records the snapshot of the frame
     void update(float dt) override;
+
+    /// @brief Renders the recorded snapshot. The registry is not accessed, but the snapshot refers to the buffers of the render components
+    void submit() const;
 };
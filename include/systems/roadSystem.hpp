@@ -36,7 +36,13 @@ class RoadSystem : public System {
 
     std::map<RoadTypes, RoadSpecs> roadSpecs;
 
-    void createRoadMesh(const RoadComponent& roadComponent, RoadMeshComponent& geometry) const;
+    using RoadTransforms = std::map<RoadTypes, std::map<RoadTileTypes, std::vector<glm::mat4>>>;
+
+    /// @brief Calculates the transformations of the road tiles of a chunk. Does not access the registry or OpenGL, so it can run on worker threads
+    static RoadTransforms calculateRoadTransforms(const RoadComponent& roadComponent);
+
+    /// @brief Fills the instance buffers of the road meshes with the calculated transformations
+    void createRoadMesh(const RoadComponent& roadComponent, RoadMeshComponent& geometry, RoadTransforms& transforms) const;
 
     void init();
 
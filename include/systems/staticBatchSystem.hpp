@@ -0,0 +1,83 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "system.hpp"
+
+#include "rendering/geometryData.hpp"
+#include "rendering/material.hpp"
+
+#include <future>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+struct BuildEvent;
+struct StaticBatchComponent;
+
+/// @brief Merges the static geometry of a chunk (placed buildings and roads) into one geometry per material
+class StaticBatchSystem : public System {
+  protected:
+    /// @brief One piece of geometry that should be part of a batch
+    struct BatchSource {
+        MaterialPtr material;
+        std::shared_ptr<const GeometryData> data;
+        glm::mat4 transform;
+    };
+
+    using BatchResult = std::vector<std::pair<MaterialPtr, GeometryData>>;
+
+    struct BatchTask {
+        unsigned int revision;
+        std::vector<entt::entity> members;
+        bool containsRoads;
+        std::future<BatchResult> result;
+    };
+
+    /// @brief Remaining time until the chunk content is considered settled
+    std::unordered_map<glm::ivec2, float> dirtyChunks;
+    std::unordered_map<glm::ivec2, BatchTask> batchTasks;
+
+    /// @brief Maximum number of batches that are built at the same time
+    static constexpr unsigned int maxBatchTasks = 2;
+
+    virtual void init() override;
+
+    /// @brief Invalidates the batch of the chunk and schedules a rebuild
+    /// @param chunkPosition The chunk position
+    void markDirty(const glm::ivec2& chunkPosition);
+
+    /// @brief Disables the batch so that the chunk content is rendered by its own components again
+    void invalidateBatch(StaticBatchComponent& batch);
+
+    /// @brief Collects the static geometry of the chunk and starts merging it on a worker thread
+    void startBatchTask(const glm::ivec2& chunkPosition, const entt::entity chunk, StaticBatchComponent& batch);
+
+    void finishBatchTask(const glm::ivec2& chunkPosition, BatchTask& task);
+
+    static BatchResult buildBatch(const std::vector<BatchSource>& sources);
+
+    void onBatchedEntityDestroyed(entt::registry& registry, entt::entity entity);
+
+  public:
+    StaticBatchSystem(Game* game);
+
+    virtual void update(float dt) override;
+
+    void handleBuildEvent(const BuildEvent& e);
+};
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "../game.hpp"
+#include "misc/systemScheduler.hpp"
 
 #include <entt/entt.hpp>
 
@@ -28,6 +29,9 @@ class System {
 
     Game* game;
 
+    /// @brief Components the update and the triggered event handlers of the system access
+    SystemAccess access;
+
     virtual void init();
 
     virtual void destroy();
@@ -38,4 +42,8 @@ class System {
     ~System();
 
     virtual void update(float dt);
+
+    inline const SystemAccess& getAccess() const {
+        return access;
+    }
 };
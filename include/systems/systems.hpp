@@ -19,7 +19,9 @@
 #include "carSystem.hpp"
 #include "debugSystem.hpp"
 #include "environmentSystem.hpp"
+#include "hierarchySystem.hpp"
 #include "physicsSystem.hpp"
 #include "renderSystem.hpp"
 #include "roadSystem.hpp"
+#include "staticBatchSystem.hpp"
 #include "terrainSystem.hpp"
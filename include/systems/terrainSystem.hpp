@@ -18,15 +18,19 @@
 
 #include "misc/terrainArea.hpp"
 
+#include <chrono>
 #include <future>
 #include <queue>
+#include <unordered_map>
 #include <vector>
 
 #include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
 #include <noise/noise.h>
 
 struct TerrainComponent;
 struct MeshComponent;
+struct OccluderComponent;
 struct BuildEvent;
 struct TextureAtlas;
 struct Vertex;
@@ -53,8 +57,11 @@ class TerrainSystem : public System {
     std::queue<glm::ivec2> chunksToGenerate;
     std::queue<glm::ivec2> chunksToCreateMesh;
     std::queue<TerrainArea> areasToUpdateMesh;
+    /// @brief Times at which the chunks were requested, used to measure the streaming latency
+    std::unordered_map<glm::ivec2, std::chrono::steady_clock::time_point> chunkRequestTimes;
 
-    static constexpr unsigned int maxThreads = 5;
+    /// @brief Size of the blocks in cells that are approximated by one quad of the occlusion hull
+    static constexpr int occluderBlockSize = 10;
     std::vector<std::pair<glm::ivec2, std::future<std::pair<GeometryData, GeometryData>>>> meshCreationTasks;
 
     void init() override;
@@ -67,6 +74,9 @@ class TerrainSystem : public System {
     static unsigned int generateTerrainQuadMesh(const glm::ivec2& position, const glm::ivec2& chunkPosition, std::vector<Vertex>& terrainVertices, float** const heightMap, TerrainSurfaceTypes surfaceType);
     static unsigned int generateWaterQuadMesh(const glm::ivec2& position, const glm::ivec2& chunkPosition, std::vector<Vertex>& waterVertices);
 
+    /// @brief Creates the occlusion hull of a chunk. Every block is covered by a quad at its lowest height, so that the hull lies below the terrain surface
+    static OccluderComponent generateTerrainOccluder(float** const heightValues);
+
     void updateTerrainMesh(const TerrainArea& area) const;
     void updateTerrainMesh(const TerrainArea& area, MeshComponent& mesh) const;
 
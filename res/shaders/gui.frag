@@ -1,54 +1,47 @@
 #version 450
 in vec2 texCoord;
 in vec2 fragPosition;
-
-struct Rectangle {
-    vec2 position;
-    vec2 size;
-};
-
-// color and texture
-uniform vec4 color;
+in vec4 color;
+flat in vec4 widgetArea;
+flat in float cornerRadius;
+flat in int type;
+flat in float layer;
+
+// pages of the glyph cache
+uniform sampler2DArray glyphAtlas;
+// icon texture
 uniform sampler2D tex;
 
-//
-uniform bool useTexture;
-uniform bool text;
-uniform float cornerRadius;
-
-// widget area
-uniform Rectangle widgetArea;
-
 out vec4 FragColor;
 
+const int TYPE_COLOR = 0;
+const int TYPE_TEXT = 1;
+const int TYPE_TEXTURE = 2;
+
 void main() {
     // render round corners if radius is greather than zero
     if (cornerRadius > 0) {
         // calculate vector pointing from the current frag to the nearest inner edge
         vec2 r = vec2(cornerRadius);
         // left bottom corner to frag pos
-        vec2 u = fragPosition - (widgetArea.position + r);
+        vec2 u = fragPosition - (widgetArea.xy + r);
         // frag pos to top right corner
-        vec2 v = widgetArea.position + widgetArea.size - r - fragPosition;
+        vec2 v = widgetArea.xy + widgetArea.zw - r - fragPosition;
 
         // minimum distance vector
-        vec2 d = min(u,v);        
+        vec2 d = min(u, v);
         if (d.x < 0 && d.y < 0 && length(d) > cornerRadius) {
             discard;
         }
-    }    
+    }
 
-    // render text and texture
-    if (text) {
-        vec4 sampled = vec4(1.0, 1.0, 1.0, texture(tex, texCoord).r);
-        FragColor = color * sampled;
+    if (type == TYPE_TEXT) {
+        FragColor = color * vec4(1.0, 1.0, 1.0, texture(glyphAtlas, vec3(texCoord, layer)).r);
     }
-    // render texture
-    else if (useTexture) {
+    else if (type == TYPE_TEXTURE) {
         FragColor = texture(tex, texCoord);
     }
-    // render color
     else {
         FragColor = color;
     }
-}
\ No newline at end of file
+}
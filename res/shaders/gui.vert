@@ -0,0 +1,30 @@
+#version 450
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in vec4 aWidgetArea;
+layout(location = 4) in float aCornerRadius;
+layout(location = 5) in float aType;
+layout(location = 6) in float aLayer;
+
+uniform mat4 projection;
+
+out vec2 texCoord;
+out vec2 fragPosition;
+out vec4 color;
+flat out vec4 widgetArea;
+flat out float cornerRadius;
+flat out int type;
+flat out float layer;
+
+void main() {
+    gl_Position = projection * vec4(aPos.xy, 0.0, 1.0);
+
+    fragPosition = aPos;
+    texCoord = aTexCoord;
+    color = aColor;
+    widgetArea = aWidgetArea;
+    cornerRadius = aCornerRadius;
+    type = int(aType + 0.5);
+    layer = aLayer;
+}
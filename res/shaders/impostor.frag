@@ -0,0 +1,44 @@
+#version 450
+in VS_OUT {
+    vec3 FragPos;
+    vec2 TexCoord;
+}
+fs_in;
+
+layout(std140, binding = 2) uniform Light {
+    mat4 lightView[cascadeCount];
+    mat4 lightProjection[cascadeCount];
+
+    vec3 lightDirection;
+
+    vec3 lightAmbient;
+    vec3 lightDiffuse;
+    vec3 lightSpecular;
+
+    float cascadeFarPlanes[cascadeCount];
+};
+
+struct Material {
+    sampler2D ambientTexture;
+    sampler2D diffuseTexture;
+    sampler2D specularTexture;
+    sampler2D normalMap;
+
+    float shininess;
+    float specularStrength;
+    float dissolve;
+};
+
+out vec4 FragColor;
+
+uniform Material material;
+
+void main() {
+    vec4 color = texture(material.diffuseTexture, fs_in.TexCoord);
+    if (color.a < 0.5) {
+        discard;
+    }
+
+    // the atlas is baked without lighting, so only the light intensity is applied
+    FragColor = vec4((lightAmbient + 0.6 * lightDiffuse) * color.rgb, 1.0);
+}
@@ -0,0 +1,51 @@
+#version 450
+// impostor quads store the center of the bounding sphere in aPos and the corner offset and the number of atlas frames in aTangent
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec3 aNormal;
+layout(location = 3) in vec3 aTangent;
+layout(location = 4) in vec3 aBitangent;
+layout(location = 5) in mat4 aModel;
+
+out VS_OUT {
+    vec3 FragPos;
+    vec2 TexCoord;
+}
+vs_out;
+
+layout(std140, binding = 1) uniform Camera {
+    mat4 view;
+    mat4 projection;
+
+    vec3 viewPos;
+    vec3 cameraTarget;
+};
+
+uniform mat4 model;
+
+const float PI = 3.14159265;
+
+void main() {
+    mat4 instanceModel = model * aModel;
+    vec3 center = vec3(instanceModel * vec4(aPos, 1.0));
+    float scale = length(vec3(instanceModel[0]));
+
+    // rotate the quad around the y axis towards the camera
+    vec3 toCamera = viewPos - center;
+    toCamera.y = 0.0;
+    vec3 direction = length(toCamera) > 0.0001 ? normalize(toCamera) : vec3(1.0, 0.0, 0.0);
+    vec3 up = vec3(0.0, 1.0, 0.0);
+    vec3 right = normalize(cross(up, direction));
+
+    vec3 position = center + scale * (aTangent.x * right + aTangent.y * up);
+
+    // select the atlas frame that was rendered from the nearest direction
+    float frames = aTangent.z;
+    vec3 localDirection = inverse(mat3(instanceModel)) * direction;
+    float angle = atan(localDirection.z, localDirection.x);
+    float frame = mod(round(angle / (2.0 * PI) * frames), frames);
+
+    gl_Position = projection * view * vec4(position, 1.0);
+    vs_out.FragPos = position;
+    vs_out.TexCoord = vec2((frame + aTexCoord.x) / frames, aTexCoord.y);
+}
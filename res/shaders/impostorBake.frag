@@ -0,0 +1,24 @@
+#version 450
+in VS_OUT {
+    vec2 TexCoord;
+}
+fs_in;
+
+struct Material {
+    sampler2D ambientTexture;
+    sampler2D diffuseTexture;
+    sampler2D specularTexture;
+    sampler2D normalMap;
+
+    float shininess;
+    float specularStrength;
+    float dissolve;
+};
+
+out vec4 FragColor;
+
+uniform Material material;
+
+void main() {
+    FragColor = vec4(texture(material.diffuseTexture, fs_in.TexCoord).rgb, 1.0);
+}
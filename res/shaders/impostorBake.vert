@@ -0,0 +1,16 @@
+#version 450
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec2 aTexCoord;
+
+out VS_OUT {
+    vec2 TexCoord;
+}
+vs_out;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    gl_Position = projection * view * vec4(aPos, 1.0);
+    vs_out.TexCoord = aTexCoord;
+}
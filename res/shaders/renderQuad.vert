@@ -1,21 +0,0 @@
-#version 450
-layout(location = 0) in vec2 aPos;
-layout(location = 1) in vec2 aTexCoord;
-
-uniform mat4 projection;
-uniform bool flipV;
-
-out vec2 texCoord;
-out vec2 fragPosition;
-
-void main() {
-    fragPosition = aPos;
-    gl_Position = projection * vec4(aPos.xy, 0.0, 1.0);
-
-    if (flipV) {
-        texCoord = vec2(aTexCoord.x, 1 - aTexCoord.y);
-    }
-    else {
-        texCoord = aTexCoord;
-    }
-}
\ No newline at end of file
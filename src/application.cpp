@@ -27,7 +27,14 @@
 #include "events/keyEvent.hpp"
 #include "events/mouseEvents.hpp"
 
+#include "misc/benchmark.hpp"
+#include "misc/profiler.hpp"
+#include "rendering/renderStats.hpp"
+
+#include <chrono>
+#include <format>
 #include <iostream>
+#include <thread>
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
@@ -67,15 +74,41 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
     app->onMouseScrollEvent(event);
 }
 
-void Application::init() {
-    if (!glfwInit()) {
-        std::cerr << "failed to intialize GLFW!" << std::endl;
-        exit(1);
-    }
+void focus_callback(GLFWwindow* window, int focused) {
+    Application* app = (Application*)glfwGetWindowUserPointer(window);
+    app->focused = focused == GLFW_TRUE;
+    app->redrawRequested = true;
+}
+
+void iconify_callback(GLFWwindow* window, int iconified) {
+    Application* app = (Application*)glfwGetWindowUserPointer(window);
+    app->iconified = iconified == GLFW_TRUE;
+    app->redrawRequested = true;
+}
 
+void refresh_callback(GLFWwindow* window) {
+    Application* app = (Application*)glfwGetWindowUserPointer(window);
+    app->redrawRequested = true;
+}
+
+void Application::createWindow() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
 
+    if (options.headless) {
+        // the window is never shown. A surfaceless EGL context is preferred and OSMesa is used if EGL is not available
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+
+        window = glfwCreateWindow(options.width, options.height, "City Building Game", NULL, NULL);
+        if (window == NULL) {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            window = glfwCreateWindow(options.width, options.height, "City Building Game", NULL, NULL);
+        }
+
+        return;
+    }
+
     // anti-aliasing
     glfwWindowHint(GLFW_SAMPLES, 4);
 
@@ -89,6 +122,22 @@ void Application::init() {
 
     window = glfwCreateWindow(width, height, "City Building Game", monitor, NULL);
 #endif
+}
+
+void Application::init() {
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4)
+    // the null platform does not need a display server
+    if (options.headless) {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+#endif
+
+    if (!glfwInit()) {
+        std::cerr << "failed to intialize GLFW!" << std::endl;
+        exit(1);
+    }
+
+    createWindow();
 
     if (window == NULL) {
         std::cerr << "Failed to create GLFW window" << std::endl;
@@ -108,13 +157,21 @@ void Application::init() {
     glfwSetCursorPosCallback(window, cursorPos_callback);
     glfwSetMouseButtonCallback(window, mouseButton_callback);
     glfwSetScrollCallback(window, scroll_callback);
+    glfwSetWindowFocusCallback(window, focus_callback);
+    glfwSetWindowIconifyCallback(window, iconify_callback);
+    glfwSetWindowRefreshCallback(window, refresh_callback);
 
     glfwSetWindowUserPointer(window, this);
 
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(0);
+    setFramePacing(options.headless || options.benchmarkEnabled() ? FramePacing::UNLIMITED : Configuration::framePacing);
 
-    glewInit();
+    // without a GLX display glew only fails to load the GLX extensions, the gl functions are loaded anyway
+    glewExperimental = GL_TRUE;
+    const GLenum glewError = glewInit();
+    if (glewError != GLEW_OK && !(options.headless && glewError == GLEW_ERROR_NO_GLX_DISPLAY)) {
+        std::cerr << "Failed to initialize GLEW: " << glewGetErrorString(glewError) << std::endl;
+    }
 
     glEnable(GL_FRAMEBUFFER_SRGB);
     glEnable(GL_DEPTH_TEST);
@@ -123,53 +180,182 @@ void Application::init() {
 
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    gpuTimer = new GpuTimer();
+
     // init gui
     gui = new Gui(this, 800, 600);
 
     // init game
     game = new Game(this);
+
+    if (options.headless) {
+        renderTarget = new RenderTarget(options.width, options.height);
+
+        glViewport(0, 0, options.width, options.height);
+        FramebufferSizeEvent event = FramebufferSizeEvent(options.width, options.height);
+        onFramebufferSizeEvent(event);
+    }
+
+    if (options.benchmarkEnabled()) {
+        benchmark = new Benchmark(game, options);
+    }
 }
 
-Application::Application() {
+Application::Application(const ApplicationOptions& options)
+    : options(options) {
     init();
 }
 
 void Application::run() {
+    if (benchmark != nullptr) {
+        runBenchmark();
+        return;
+    }
+
     glfwSetTime(0);
     float lastTime = 0;
 
     while (!stopRequested) {
-        float currentTime = (float)glfwGetTime();
-        updateTime = currentTime - lastTime;
-        lastTime = currentTime;
+        const double frameStart = glfwGetTime();
+
+        // while the game is paused nothing changes without input, except for glyphs that are loaded in the background
+        const bool paused = getGameState() == GameState::PAUSED;
+        if (!paused || redrawRequested || gui->hasPendingWork()) {
+            float currentTime = (float)frameStart;
+            updateTime = currentTime - lastTime;
+            lastTime = currentTime;
+
+            frame();
+        }
+        else {
+            // the time without frames is not simulated
+            lastTime = (float)glfwGetTime();
+        }
+
+        redrawRequested = false;
+
+        if (paused) {
+            glfwWaitEventsTimeout(1.0 / Configuration::idleFps);
+        }
+        else if (!focused || iconified) {
+            // the game keeps running, so the frames are only throttled as far as the simulation steps of a frame cover the frame time
+            glfwWaitEventsTimeout(1.0 / Configuration::backgroundFps);
+        }
+        else {
+            glfwPollEvents();
+
+            if (framePacing == FramePacing::TARGET_FPS) {
+                limitFrameRate(frameStart);
+            }
+        }
 
-        // glClearColor(0.7f, 0.877f, 0.917f, 1.0f);
-        // glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        stopRequested |= (glfwWindowShouldClose(window) != 0);
+    }
 
-        game->update(updateTime);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+}
+
+void Application::frame() {
+    PROFILE_FUNCTION();
+
+    gpuTimer->beginFrame();
+    RenderStats::get().beginFrame();
 
-        gui->update();
-        gui->render();
+    // glClearColor(0.7f, 0.877f, 0.917f, 1.0f);
+    // glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    game->update(updateTime);
+
+    gui->update();
+
+    gpuTimer->begin(RenderPass::GUI);
+    RenderStats::get().setPass(RenderPass::GUI);
+    gui->render();
+    RenderStats::get().setPass(RenderPass::OTHER);
+    gpuTimer->end(RenderPass::GUI);
+
+    if (options.headless) {
+        // there is no swap chain that limits the frames in flight
+        glFinish();
+    }
+    else {
         glfwSwapBuffers(window);
-        glfwPollEvents();
+    }
+}
+
+void Application::runBenchmark() {
+    while (!benchmark->finished() && !stopRequested) {
+        const double frameStart = glfwGetTime();
+
+        // the fixed time step makes the simulation and the camera path independent of the frame times
+        updateTime = Configuration::simulationTimeStep;
+
+        frame();
 
+        benchmark->recordFrame(static_cast<float>(glfwGetTime() - frameStart), *gpuTimer);
+
+        glfwPollEvents();
         stopRequested |= (glfwWindowShouldClose(window) != 0);
     }
 
+    benchmark->writeReport();
+
     glfwDestroyWindow(window);
     glfwTerminate();
 }
 
+void Application::limitFrameRate(double frameStart) const {
+    const double frameEnd = frameStart + 1.0 / Configuration::targetFps;
+
+    // sleep for the most of the remaining time and spin for the rest
+    const double sleepTime = frameEnd - glfwGetTime() - Configuration::frameLimiterSpinTime;
+    if (sleepTime > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(sleepTime));
+    }
+
+    while (glfwGetTime() < frameEnd) {
+        std::this_thread::yield();
+    }
+}
+
 void Application::stop() {
     stopRequested = true;
 }
 
+void Application::setFramePacing(FramePacing pacing) {
+    framePacing = pacing;
+
+    glfwSwapInterval(pacing == FramePacing::VSYNC ? 1 : 0);
+}
+
+FramePacing Application::getFramePacing() const {
+    return framePacing;
+}
+
 GLFWwindow* Application::getWindow() const {
     return window;
 }
 
 void Application::onKeyEvent(KeyEvent& e) {
+    redrawRequested = true;
+
+    // cycle through the frame pacing modes
+    if (e.action == GLFW_PRESS && e.key == GLFW_KEY_F5) {
+        setFramePacing(static_cast<FramePacing>((static_cast<int>(framePacing) + 1) % 3));
+        e.handled = true;
+        return;
+    }
+
+#ifdef PROFILING
+    // write the recorded profiling zones
+    if (e.action == GLFW_PRESS && e.key == GLFW_KEY_F6) {
+        Profiler::get().writeTrace(std::format("trace_{}.json", static_cast<long long>(glfwGetTime() * 1000.0)));
+        e.handled = true;
+        return;
+    }
+#endif
+
     gui->handleKeyEvent(e);
 
     if (!e.handled) {
@@ -178,18 +364,24 @@ void Application::onKeyEvent(KeyEvent& e) {
 }
 
 void Application::onFramebufferSizeEvent(FramebufferSizeEvent& e) {
+    redrawRequested = true;
+
     gui->setScreenSize(e.width, e.height);
 
     game->raiseEvent(e);
 }
 
 void Application::onMouseMoveEvent(MouseMoveEvent& e) {
+    redrawRequested = true;
+
     game->raiseEvent(e);
 
     gui->handleMouseMoveEvent(e);
 }
 
 void Application::onMouseButtonEvent(MouseButtonEvent& e) {
+    redrawRequested = true;
+
     gui->handleMouseButtonEvent(e);
 
     if (!e.handled) {
@@ -198,5 +390,7 @@ void Application::onMouseButtonEvent(MouseButtonEvent& e) {
 }
 
 void Application::onMouseScrollEvent(MouseScrollEvent& e) {
+    redrawRequested = true;
+
     game->raiseEvent(e);
 }
@@ -23,39 +23,51 @@ TransformationComponent::TransformationComponent(const glm::vec3& position, cons
 }
 
 void TransformationComponent::calculateTransform() {
+    setTransform(calculateMatrix());
+    dirty = false;
+}
+
+glm::mat4 TransformationComponent::calculateMatrix() const {
     glm::mat4 rotation = glm::toMat4(this->rotation);
 
-    transform = glm::translate(position) * glm::scale(scale) * rotation;
+    return glm::translate(position) * glm::scale(scale) * rotation;
 }
 
 void TransformationComponent::translate(const glm::vec3& translation) {
     position += translation;
+    dirty = true;
 }
 
 void TransformationComponent::setPosition(const glm::vec3& position) {
     this->position = position;
+    dirty = true;
 }
 
 void TransformationComponent::rotate(const glm::vec3& axis, float angle) {
     glm::quat dRot = glm::angleAxis(angle, axis);
 
     rotation = dRot * rotation;
+    dirty = true;
 }
 
 void TransformationComponent::setRotation(const glm::vec3& axis, float angle) {
     rotation = glm::angleAxis(angle, axis);
+    dirty = true;
 }
 
 void TransformationComponent::setRotation(const glm::vec3& eulerAngles) {
     rotation = glm::quat(eulerAngles);
+    dirty = true;
 }
 
 void TransformationComponent::addScale(const glm::vec3& scale) {
     this->scale *= scale;
+    dirty = true;
 }
 
 void TransformationComponent::setScale(const glm::vec3& scale) {
     this->scale = scale;
+    dirty = true;
 }
 
 void TransformationComponent::assignToEntity(const entt::entity entity, entt::registry& registry) const {
@@ -18,23 +18,36 @@
 #include "application.hpp"
 #include "components/components.hpp"
 #include "events/events.hpp"
+#include "misc/configuration.hpp"
 #include "misc/coordinateTransform.hpp"
+#include "misc/profiler.hpp"
 #include "misc/utility.hpp"
 #include "rendering/geometry.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/texture.hpp"
 #include "systems/systems.hpp"
 
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+
 Game::Game(Application* app)
-    : app(app), resourceManager("res/"), terrain(this) {
+    : app(app), resourceManager("res/"), scheduler(registry), terrain(this) {
+    terrain.seed = app->getOptions().seed;
+    scheduler.setValidation(app->getOptions().validateSystems);
     logStream = std::ofstream("log.txt");
 
+    // the registered events are delivered in batches by the flush of the frame
+    eventBus.registerEvent<ChunkCreatedEvent>();
+    eventBus.registerEvent<EntityMoveEvent>();
+
     init();
 }
 
 void Game::init() {
     // init camera system
-    systems.push_back(new CameraSystem(this));
+    cameraSystem = new CameraSystem(this);
+    inputSystems.push_back(cameraSystem);
     // entities
     camera = registry.view<CameraComponent>().front();
     sun = registry.create();
@@ -43,11 +56,16 @@ void Game::init() {
     systems.push_back(new BuildSystem(this));
     systems.push_back(new TerrainSystem(this));
     systems.push_back(new RoadSystem(this));
-    systems.push_back(new CarSystem(this));
+    carSystem = new CarSystem(this);
+    concurrentSystems.push_back(carSystem);
     systems.push_back(new EnvironmentSystem(this));
-    systems.push_back(new PhysicsSystem(this));
-    systems.push_back(new DebugSystem(this));
-    systems.push_back(new RenderSystem(this));
+    concurrentSystems.push_back(new PhysicsSystem(this));
+    systems.push_back(new StaticBatchSystem(this));
+    hierarchySystem = new HierarchySystem(this);
+    renderSystems.push_back(new DebugSystem(this));
+
+    renderSystem = new RenderSystem(this);
+    renderSystems.push_back(renderSystem);
 }
 
 entt::registry& Game::getRegistry() {
@@ -63,15 +81,139 @@ ResourceManager& Game::getResourceManager() {
 }
 
 void Game::update(float dt) {
+    PROFILE_FUNCTION();
+
     if (state == GameState::PAUSED) {
         // update render system
-        systems.back()->update(dt);
+        renderSystem->update(dt);
+        renderSystem->submit();
+        return;
+    }
+
+    // the simulation is updated in fixed steps independent of the frame rate
+    accumulator += dt;
+
+    int steps = 0;
+    while (accumulator >= Configuration::simulationTimeStep && steps < Configuration::maxSimulationSteps) {
+        accumulator -= Configuration::simulationTimeStep;
+        steps++;
+    }
+
+    // drop the time that could not be simulated, so that slow frames do not cause even more steps in the next frames
+    if (steps == Configuration::maxSimulationSteps) {
+        accumulator = std::min(accumulator, Configuration::simulationTimeStep);
     }
-    else {
+
+    // the systems are added in the serial order of the frame. Systems whose access does not conflict run at the same time
+    for (System* system : inputSystems) {
+        scheduler.add(system, dt);
+    }
+
+    for (int i = 0; i < steps; i++) {
         for (System* system : systems) {
-            system->update(dt);
+            scheduler.add(system, Configuration::simulationTimeStep);
+        }
+
+        scheduler.add("Game::storePreviousTransforms", SystemAccess().read<TransformationComponent>().write<InterpolationComponent>(), [this]() {
+            storePreviousTransforms();
+        });
+
+        for (System* system : concurrentSystems) {
+            scheduler.add(system, Configuration::simulationTimeStep);
+        }
+    }
+
+    // the cars are written into their instances once per frame instead of after every step
+    if (steps > 0) {
+        scheduler.add("CarSystem::updateInstances", SystemAccess().write<InstancedMeshComponent>().runAfter<CarSystem>(), [this]() {
+            carSystem->updateInstances();
+        });
+    }
+
+    // the posted events are delivered before the frame is rendered. The node is structural, so no system runs while the handlers change the registry
+    SystemAccess flushAccess;
+    flushAccess.mainThread = true;
+    flushAccess.structural = true;
+    scheduler.add("Game::flushEvents", flushAccess, [this]() {
+        eventBus.flush(eventDispatcher);
+    });
+
+    const float alpha = accumulator / Configuration::simulationTimeStep;
+    scheduler.add("Game::interpolateTransforms", SystemAccess().read<InterpolationComponent, VelocityComponent, ParentComponent>().write<TransformationComponent>(), [this, alpha]() {
+        interpolateTransforms(alpha);
+    });
+
+    // attached entities follow the interpolated matrices of their parents
+    scheduler.add(hierarchySystem, dt);
+
+    SystemScheduler::NodeId renderNode = 0;
+    for (System* system : renderSystems) {
+        const SystemScheduler::NodeId node = scheduler.add(system, dt);
+
+        if (system == renderSystem) {
+            renderNode = node;
         }
     }
+
+    // moving entities are interpolated. The components are added at the end of the frame, so that the steps of the next frame do not change the registry structure
+    SystemAccess interpolationAccess;
+    interpolationAccess.structural = true;
+    interpolationAccess.read<TransformationComponent, VelocityComponent, ParentComponent>().write<InterpolationComponent>();
+    scheduler.add("Game::addInterpolationComponents", interpolationAccess, [this]() {
+        addInterpolationComponents();
+    });
+
+    // the frame is submitted in the frame it was recorded in. The snapshot refers to the buffers of the render components,
+    // so the systems that write them are not run while it is submitted
+    SystemAccess submitAccess;
+    submitAccess.mainThread = true;
+    submitAccess.read<MeshComponent, InstancedMeshComponent, MultiInstancedMeshComponent, RoadMeshComponent, TerrainComponent, StaticBatchComponent, InstanceCullingComponent>();
+    const SystemScheduler::NodeId submitNode = scheduler.add("RenderSystem::submit", submitAccess, [this]() {
+        renderSystem->submit();
+    });
+    scheduler.precede(renderNode, submitNode);
+
+    scheduler.run();
+}
+
+void Game::storePreviousTransforms() {
+    PROFILE_FUNCTION();
+    registry.view<TransformationComponent, InterpolationComponent>().each([](const TransformationComponent& transform, InterpolationComponent& interpolation) {
+        interpolation.previousPosition = transform.position;
+        interpolation.previousRotation = transform.rotation;
+        interpolation.previousScale = transform.scale;
+    });
+}
+
+void Game::addInterpolationComponents() {
+    registry.view<TransformationComponent, VelocityComponent>(entt::exclude<InterpolationComponent, ParentComponent>).each([&](const entt::entity entity, const TransformationComponent& transform, const VelocityComponent& velocity) {
+        registry.emplace<InterpolationComponent>(entity, transform.position, transform.rotation, transform.scale);
+    });
+}
+
+void Game::interpolateTransforms(float alpha) {
+    PROFILE_FUNCTION();
+    // only the matrix is interpolated. The position, rotation and scale keep the simulation state
+    registry.view<TransformationComponent, InterpolationComponent>().each([alpha](TransformationComponent& transform, const InterpolationComponent& interpolation) {
+        // entities that did not move in the last step only need their matrix once
+        if (interpolation.previousPosition == transform.position && interpolation.previousRotation == transform.rotation && interpolation.previousScale == transform.scale) {
+            transform.updateTransform();
+            return;
+        }
+
+        const glm::vec3 position = glm::mix(interpolation.previousPosition, transform.position, alpha);
+        const glm::quat rotation = glm::slerp(interpolation.previousRotation, transform.rotation, alpha);
+        const glm::vec3 scale = glm::mix(interpolation.previousScale, transform.scale, alpha);
+
+        transform.setTransform(glm::translate(position) * glm::scale(scale) * glm::toMat4(rotation));
+        // the matrix lies between two steps, so it is recalculated when the entity stops
+        transform.dirty = true;
+    });
+
+    // moving entities that are not interpolated yet
+    registry.view<TransformationComponent, VelocityComponent>(entt::exclude<InterpolationComponent, ParentComponent>).each([](TransformationComponent& transform, const VelocityComponent&) {
+        transform.updateTransform();
+    });
 }
 
 void Game::reloadResources() {
@@ -139,10 +281,8 @@ template void Game::raiseEvent<KeyEvent>(KeyEvent&);
 template void Game::raiseEvent<MouseButtonEvent>(MouseButtonEvent&);
 template void Game::raiseEvent<MouseMoveEvent>(MouseMoveEvent&);
 template void Game::raiseEvent<MouseScrollEvent>(MouseScrollEvent&);
-template void Game::raiseEvent<ChunkCreatedEvent>(ChunkCreatedEvent&);
 template void Game::raiseEvent<ChunkDestroyedEvent>(ChunkDestroyedEvent&);
 template void Game::raiseEvent<ChunkUpdatedEvent>(ChunkUpdatedEvent&);
-template void Game::raiseEvent<EntityMoveEvent>(EntityMoveEvent&);
 
 #if DEBUG
 void Game::log(const std::string& message) {
@@ -45,7 +45,7 @@ void Container::addChild(Widget* child) {
     children.push_back(child);
     child->parent = this;
 
-    setChildConstraints();
+    invalidateLayout();
 }
 
 Widget* Container::getChild(const std::string& id) const {
@@ -80,6 +80,12 @@ void Container::update() {
     }
 }
 
+void Container::arrangeChildren() {
+    for (Widget* child : children) {
+        child->arrange(box);
+    }
+}
+
 void Container::render() const {
     Widget::render();
 
@@ -17,8 +17,6 @@
 
 #include "gui/gui.hpp"
 
-#include <GL/glew.h>
-
 Icon::Icon(const std::string& id, Gui* gui, Texture* texture, const glm::vec4& backgroundColor)
     : Widget(id, gui, backgroundColor), texture(texture) {
 }
@@ -26,17 +24,5 @@ Icon::Icon(const std::string& id, Gui* gui, Texture* texture, const glm::vec4& b
 void Icon::render() const {
     Widget::render();
 
-    glActiveTexture(GL_TEXTURE0);
-
-    const Rectangle& box = getBox();
-
-    ShaderProgram* guiShader = gui->getShader();
-    guiShader->setInt("tex", 0);
-    guiShader->setBool("useTexture", true);
-
-    texture->use(0);
-
-    gui->getRenderQuad().draw(box.x, box.y, box.width, box.height);
-
-    guiShader->setBool("useTexture", false);
+    gui->getRenderer()->drawTexture(getBox(), texture);
 }
@@ -20,25 +20,57 @@ Label::Label(const std::string& id, Gui* gui, const glm::vec4& backgroundColor,
     : Widget(id, gui, backgroundColor), text(text), textSize(textSize), textColor(textColor) {
 }
 
-Rectangle Label::getBox() const {
-    if (constraints.height.type != ConstraintType::FIT_TO_CONTENT && constraints.width.type != ConstraintType::FIT_TO_CONTENT) {
-        return Widget::getBox();
+const std::string& Label::getText() const {
+    return text;
+}
+
+void Label::setText(std::string_view text) {
+    if (this->text == text) {
+        return;
+    }
+
+    this->text = text;
+    layout.reset();
+
+    // only the labels whose size depends on the text have to be arranged again
+    if (fitsContent() && measure(parentBox) != glm::vec2(box.width, box.height)) {
+        invalidateLayout();
     }
+}
 
-    Rectangle parentBox = Widget::getBox();
+bool Label::fitsContent() const {
+    return constraints.height.type == ConstraintType::FIT_TO_CONTENT || constraints.width.type == ConstraintType::FIT_TO_CONTENT;
+}
+
+const TextLayout& Label::getLayout() const {
+    // the layout is created again if glyphs were added to or removed from the glyph cache
+    if (!layout || layout->textSize != textSize || layout->generation != gui->textRenderer.getGeneration()) {
+        layout = gui->textRenderer.getLayout(text, textSize);
+    }
+
+    return *layout;
+}
+
+glm::vec2 Label::measure(const Rectangle& parentBox) const {
+    glm::vec2 size = Widget::measure(parentBox);
 
     if (constraints.height.type == ConstraintType::FIT_TO_CONTENT) {
-        float baselineoffset;
-        float height = gui->textRenderer.getHeight(text, textSize, &baselineoffset);
-        parentBox.height = height;
+        size.y = getLayout().height;
     }
 
     if (constraints.width.type == ConstraintType::FIT_TO_CONTENT) {
-        float width = gui->textRenderer.getWidth(text, textSize);
-        parentBox.width = width;
+        size.x = getLayout().width;
     }
 
-    return parentBox;
+    return size;
+}
+
+void Label::update() {
+    if (fitsContent() && layout && layout->generation != gui->textRenderer.getGeneration()) {
+        if (measure(parentBox) != glm::vec2(box.width, box.height)) {
+            invalidateLayout();
+        }
+    }
 }
 
 void Label::render() const {
@@ -48,15 +80,5 @@ void Label::render() const {
 
     Widget::render();
 
-    const Rectangle& box = getBox();
-    ShaderProgram* guiShader = gui->getShader();
-
-    guiShader->setBool("flipV", true);
-    guiShader->setBool("text", true);
-    guiShader->setVector4("color", textColor);
-
-    gui->textRenderer.renderText(text, box, textSize, textAlign);
-
-    guiShader->setBool("flipV", false);
-    guiShader->setBool("text", false);
+    gui->textRenderer.renderText(*gui->getRenderer(), getLayout(), getBox(), textAlign, textColor);
 }
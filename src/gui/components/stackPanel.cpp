@@ -19,273 +19,103 @@ StackPanel::StackPanel(const std::string& id, Gui* gui, StackOrientation orienta
     : Container(id, gui, backgroundColor), orientation{orientation}, itemAligment{itemAligment} {
 }
 
-void StackPanel::setChildConstraints() {
-    for (const auto& child : children) {
-        Container* container = dynamic_cast<Container*>(child);
-        if (container != nullptr) {
-            container->setChildConstraints();
-        }
-    }
+glm::vec2 StackPanel::measure(const Rectangle& parentBox) const {
+    glm::vec2 size = Widget::measure(parentBox);
 
-    Rectangle containerBox = getBox();
+    const bool column = orientation == StackOrientation::COLUMN || orientation == StackOrientation::COLUMN_REVERSE;
 
     if (!outerSpacing) {
-        if (orientation == StackOrientation::COLUMN || orientation == StackOrientation::COLUMN_REVERSE) {
-            containerBox.height += spacing;
+        if (column) {
+            size.y -= spacing;
         }
         else {
-            containerBox.width += spacing;
+            size.x -= spacing;
         }
     }
 
-    switch (itemAligment) {
-        case ItemAligment::STRECH: {
-            float spacing = 1.0f / children.size();
-
-            switch (orientation) {
-                case StackOrientation::COLUMN:
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.y = RelativeConstraint(i * spacing);
-                        children[i]->constraints.height = RelativeConstraint(spacing);
-                    }
-                    break;
-                case StackOrientation::COLUMN_REVERSE:
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.y = RelativeConstraint(1 - (i + 1) * spacing);
-                        children[i]->constraints.height = RelativeConstraint(spacing);
-                    }
-                    break;
-                case StackOrientation::ROW:
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.x = RelativeConstraint(i * spacing);
-                        children[i]->constraints.width = RelativeConstraint(spacing);
-                    }
-                    break;
-                case StackOrientation::ROW_REVERSE:
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.x = RelativeConstraint(1 - (i + 1) * spacing);
-                        children[i]->constraints.width = RelativeConstraint(spacing);
-                    }
-                default:
-                    break;
-            }
-        } break;
-        case ItemAligment::BEGIN: {
-            float current = spacing / 2.0f;
-
-            switch (orientation) {
-                case StackOrientation::COLUMN:
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.y = AbsoluteConstraint(current);
-
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.height + spacing);
-                    }
-                    break;
-                case StackOrientation::COLUMN_REVERSE:
-                    for (int i = children.size() - 1; i >= 0; i--) {
-                        children[i]->constraints.y = AbsoluteConstraint(current);
-
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.height + spacing);
-                    }
-                    break;
-                case StackOrientation::ROW:
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.x = AbsoluteConstraint(current);
-
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.width + spacing);
-                    }
-                    break;
-                case StackOrientation::ROW_REVERSE:
-                    for (int i = children.size() - 1; i >= 0; i--) {
-                        children[i]->constraints.x = AbsoluteConstraint(current);
-
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.width + spacing);
-                    }
-                default:
-                    break;
-            }
-        } break;
-        case ItemAligment::CENTER: {
-            float current = 0;
-            switch (orientation) {
-                case StackOrientation::COLUMN: {
-                    float height = 0.0f;
-                    for (const auto child : children) {
-                        const Rectangle& childArea = child->getBox();
-                        height += (childArea.height + spacing);
-                    }
-
-                    current = (containerBox.height - height + spacing) / 2.0f;
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.y = AbsoluteConstraint(current);
-
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.height + spacing);
-                    }
-                } break;
-                case StackOrientation::COLUMN_REVERSE: {
-                    float height = 0.0f;
-                    for (const auto child : children) {
-                        const Rectangle& childArea = child->getBox();
-                        height += (childArea.height + spacing);
-                    }
-
-                    current = (containerBox.height - height + spacing) / 2.0f;
-                    for (int i = children.size() - 1; i >= 0; i--) {
-                        children[i]->constraints.y = AbsoluteConstraint(current);
-
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.height + spacing);
-                    }
-                } break;
-                case StackOrientation::ROW: {
-                    float width = 0.0f;
-                    for (const auto child : children) {
-                        const Rectangle& childArea = child->getBox();
-                        width += (childArea.width + spacing);
-                    }
-
-                    current = (containerBox.width - width + spacing) / 2.0f;
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.x = AbsoluteConstraint(current);
-
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.width + spacing);
-                    }
-                } break;
-                case StackOrientation::ROW_REVERSE: {
-                    float width = 0.0f;
-                    for (const auto child : children) {
-                        const Rectangle& childArea = child->getBox();
-                        width += (childArea.width + spacing);
-                    }
-
-                    current = (containerBox.width - width + spacing) / 2.0f;
-                    for (int i = children.size() - 1; i >= 0; i--) {
-                        children[i]->constraints.x = AbsoluteConstraint(current);
-
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.width + spacing);
-                    }
-                } break;
-                default:
-                    break;
-            }
-        } break;
-        case ItemAligment::END: {
-            float current = 0.0f;
-
-            switch (orientation) {
-                case StackOrientation::COLUMN: {
-                    float height = 0.0f;
-                    for (const Widget* child : children) {
-                        const Rectangle& area = child->getBox();
-                        height += (area.height + spacing);
-                    }
-
-                    current = (containerBox.height - height) + spacing / 2.0f;
-
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.y = AbsoluteConstraint(current);
+    if (constraints.height.type == ConstraintType::FIT_TO_CONTENT || constraints.width.type == ConstraintType::FIT_TO_CONTENT) {
+        const Rectangle contentBox = Rectangle{0, 0, size.x, size.y};
 
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.height + spacing);
-                    }
-                } break;
-                case StackOrientation::COLUMN_REVERSE: {
-                    float height = 0.0f;
-                    for (const Widget* child : children) {
-                        const Rectangle& area = child->getBox();
-                        height += (area.height + spacing);
-                    }
+        glm::vec2 maxSize = glm::vec2(0.0f);
+        for (const Widget* child : children) {
+            maxSize = glm::max(maxSize, child->measure(contentBox));
+        }
 
-                    current = (containerBox.height - height) + spacing / 2.0f;
+        if (constraints.height.type == ConstraintType::FIT_TO_CONTENT) {
+            size.y = maxSize.y;
+        }
 
-                    for (int i = children.size() - 1; i >= 0; i--) {
-                        children[i]->constraints.y = AbsoluteConstraint(current);
+        if (constraints.width.type == ConstraintType::FIT_TO_CONTENT) {
+            size.x = maxSize.x;
+        }
+    }
 
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.height + spacing);
-                    }
-                } break;
-                case StackOrientation::ROW: {
-                    float width = 0.0f;
-                    for (const Widget* child : children) {
-                        const Rectangle& area = child->getBox();
-                        width += (area.width + spacing);
-                    }
+    return size;
+}
 
-                    current = (containerBox.width - width) + spacing / 2.0f;
+void StackPanel::setChildConstraint(Widget* child, bool position, const Constraint& value) const {
+    const bool column = orientation == StackOrientation::COLUMN || orientation == StackOrientation::COLUMN_REVERSE;
 
-                    for (int i = 0; i < children.size(); i++) {
-                        children[i]->constraints.x = AbsoluteConstraint(current);
+    Constraint& constraint = position ? (column ? child->constraints.y : child->constraints.x) : (column ? child->constraints.height : child->constraints.width);
+    if (constraint.type != value.type || constraint.value != value.value) {
+        constraint = value;
+        child->layoutDirty = true;
+    }
+}
 
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.width + spacing);
-                    }
-                } break;
-                case StackOrientation::ROW_REVERSE: {
-                    float width = 0.0f;
-                    for (const Widget* child : children) {
-                        const Rectangle& area = child->getBox();
-                        width += (area.width + spacing);
-                    }
+void StackPanel::arrangeChildren() {
+    if (children.empty()) {
+        return;
+    }
 
-                    current = (containerBox.width - width) + spacing / 2.0f;
+    const bool column = orientation == StackOrientation::COLUMN || orientation == StackOrientation::COLUMN_REVERSE;
+    const bool reverse = orientation == StackOrientation::COLUMN_REVERSE || orientation == StackOrientation::ROW_REVERSE;
 
-                    for (int i = children.size() - 1; i >= 0; i--) {
-                        children[i]->constraints.x = AbsoluteConstraint(current);
+    if (itemAligment == ItemAligment::STRECH) {
+        const float size = 1.0f / children.size();
 
-                        const Rectangle& childArea = children[i]->getBox();
-                        current += (childArea.width + spacing);
-                    }
-                } break;
-                default:
-                    break;
-            }
-        } break;
+        for (int i = 0; i < children.size(); i++) {
+            setChildConstraint(children[i], true, RelativeConstraint(reverse ? 1 - (i + 1) * size : i * size));
+            setChildConstraint(children[i], false, RelativeConstraint(size));
+        }
     }
-}
-
-Rectangle StackPanel::getBox() const {
-    Rectangle box = Widget::getBox();
-
-    if (!outerSpacing) {
-        if (orientation == StackOrientation::COLUMN || orientation == StackOrientation::COLUMN_REVERSE) {
-            box.height -= spacing;
+    else {
+        // the outer spacing was removed from the box when it was measured
+        float extent = column ? box.height : box.width;
+        if (!outerSpacing) {
+            extent += spacing;
         }
-        else {
-            box.width -= spacing;
+
+        std::vector<float> sizes(children.size());
+        float total = 0.0f;
+        for (int i = 0; i < children.size(); i++) {
+            const glm::vec2& size = children[i]->measure(box);
+            sizes[i] = column ? size.y : size.x;
+            total += sizes[i] + spacing;
         }
-    }
 
-    if (constraints.height.type == ConstraintType::FIT_TO_CONTENT) {
-        float maxHeight = 0.0f;
-        for (const auto child : children) {
-            const Rectangle& childBox = child->getBox();
-            if (childBox.height > maxHeight) {
-                maxHeight = childBox.height;
-            }
+        float current = 0.0f;
+        switch (itemAligment) {
+            case ItemAligment::BEGIN:
+                current = spacing / 2.0f;
+                break;
+            case ItemAligment::CENTER:
+                current = (extent - total + spacing) / 2.0f;
+                break;
+            case ItemAligment::END:
+                current = (extent - total) + spacing / 2.0f;
+                break;
+            default:
+                break;
         }
 
-        box.height = maxHeight;
-    }
+        for (int j = 0; j < children.size(); j++) {
+            const int i = reverse ? children.size() - 1 - j : j;
+            setChildConstraint(children[i], true, AbsoluteConstraint(current));
 
-    if (constraints.width.type == ConstraintType::FIT_TO_CONTENT) {
-        float maxWidth = 0.0f;
-        for (const auto child : children) {
-            const Rectangle& childBox = child->getBox();
-            if (childBox.width > maxWidth) {
-                maxWidth = childBox.width;
-            }
+            current += sizes[i] + spacing;
         }
-
-        box.width = maxWidth;
     }
 
-    return box;
+    Container::arrangeChildren();
 }
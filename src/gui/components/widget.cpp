@@ -73,29 +73,43 @@ void Widget::render() const {
         return;
     }
 
-    Rectangle area = getBox();
+    gui->getRenderer()->drawRect(getBox(), backgroundColor, cornerRadius);
+}
 
-    ShaderProgram* guiShader = gui->getShader();
-    guiShader->setVector4("color", backgroundColor);
-    guiShader->setVector2("widgetArea.position", glm::vec2{area.x, area.y});
-    guiShader->setVector2("widgetArea.size", glm::vec2{area.width, area.height});
-    guiShader->setFloat("cornerRadius", cornerRadius);
+const Constraints& Widget::getConstraints() const {
+    return constraints;
+}
 
-    const RenderQuad& quad = gui->getRenderQuad();
-    quad.draw(area.x, area.y, area.width, area.height);
+void Widget::setX(const Constraint& x) {
+    constraints.x = x;
+    invalidateLayout();
 }
 
-Rectangle Widget::getBox() const {
-    Rectangle parentBox;
-    if (parent == nullptr) {
-        // friend class Widget
-        parentBox = gui->getBox();
-    }
-    else {
-        // TODO: Split functions to getPos, getWidth and getHeight
-        parentBox = parent->getBox();
+void Widget::setY(const Constraint& y) {
+    constraints.y = y;
+    invalidateLayout();
+}
+
+void Widget::setWidth(const Constraint& width) {
+    constraints.width = width;
+    invalidateLayout();
+}
+
+void Widget::setHeight(const Constraint& height) {
+    constraints.height = height;
+    invalidateLayout();
+}
+
+void Widget::invalidateLayout() {
+    // the size of the parents can depend on the size of the children
+    Widget* widget = this;
+    while (widget != nullptr && !widget->layoutDirty) {
+        widget->layoutDirty = true;
+        widget = widget->parent;
     }
+}
 
+glm::vec2 Widget::measure(const Rectangle& parentBox) const {
     // set width and height values
     float width = 0, height = 0;
     switch (constraints.height.type) {
@@ -127,6 +141,19 @@ Rectangle Widget::getBox() const {
         width = height * constraints.width.value;
     }
 
+    return glm::vec2(width, height);
+}
+
+void Widget::arrange(const Rectangle& parentBox) {
+    if (!layoutDirty && parentBox == this->parentBox) {
+        return;
+    }
+
+    this->parentBox = parentBox;
+    layoutDirty = false;
+
+    const glm::vec2& size = measure(parentBox);
+
     // set coordinates of top left corner
     float x = parentBox.x;
     float y = parentBox.y;
@@ -138,7 +165,7 @@ Rectangle Widget::getBox() const {
             x += constraints.x.value * parentBox.width;
             break;
         case ConstraintType::CENTER:
-            x += (parentBox.width - width) * 0.5f;
+            x += (parentBox.width - size.x) * 0.5f;
             break;
         default:
             break;
@@ -152,11 +179,20 @@ Rectangle Widget::getBox() const {
             y += constraints.y.value * parentBox.height;
             break;
         case ConstraintType::CENTER:
-            y += (parentBox.height - height) * 0.5f;
+            y += (parentBox.height - size.y) * 0.5f;
             break;
         default:
             break;
     }
 
-    return Rectangle{x, y, width, height};
+    box = Rectangle{x, y, size.x, size.y};
+
+    arrangeChildren();
+}
+
+void Widget::arrangeChildren() {
+}
+
+const Rectangle& Widget::getBox() const {
+    return box;
 }
@@ -28,6 +28,7 @@
 #include "events/keyEvent.hpp"
 #include "events/mouseEvents.hpp"
 
+#include "misc/profiler.hpp"
 #include "rendering/texture.hpp"
 
 #include "application.hpp"
@@ -43,7 +44,10 @@ Gui::Gui(Application* app, float width, float height)
 }
 
 void Gui::init() {
+    renderer = new GuiRenderer();
+
     textRenderer.init();
+    renderer->setGlyphAtlas(textRenderer.getAtlasTexture());
 
     pauseMenu = new PauseMenu(this);
     optionsMenu = new OptionsMenu(this);
@@ -102,7 +106,7 @@ void Gui::popMenu() {
 }
 
 void Gui::showWarning(const std::string& text) const {
-    warningWidget->text = text;
+    warningWidget->setText(text);
     warningWidget->show();
 }
 
@@ -114,12 +118,8 @@ Application* Gui::getApp() const {
     return app;
 }
 
-ShaderProgram* Gui::getShader() const {
-    return guiShader;
-}
-
-const RenderQuad& Gui::getRenderQuad() const {
-    return quad;
+GuiRenderer* Gui::getRenderer() const {
+    return renderer;
 }
 
 void Gui::setScreenSize(float width, float height) {
@@ -129,13 +129,7 @@ void Gui::setScreenSize(float width, float height) {
 
     textRenderer.setScreenSize(width, height);
 
-    // update widgets
-    for (const auto& widget : widgets) {
-        Container* container;
-        if ((container = dynamic_cast<Container*>(widget)) != nullptr) {
-            container->setChildConstraints();
-        }
-    }
+    // the widgets are arranged in the new box in the next update
 }
 
 Rectangle Gui::getBox() const {
@@ -143,25 +137,40 @@ Rectangle Gui::getBox() const {
 }
 
 void Gui::update() {
+    PROFILE_FUNCTION();
+    textRenderer.update();
+
     for (Widget* widget : widgets) {
         widget->update();
     }
+    warningWidget->update();
+
+    updateLayout();
 }
 
-void Gui::render() const {
-    // bind the shader
-    guiShader->use();
+bool Gui::hasPendingWork() const {
+    return textRenderer.hasPendingGlyphs();
+}
+
+void Gui::updateLayout() {
+    PROFILE_FUNCTION();
+    // only the widgets that changed or whose parent box changed are arranged again
+    const Rectangle& box = getBox();
+
+    for (Widget* widget : widgets) {
+        widget->arrange(box);
+    }
+    warningWidget->arrange(box);
+}
 
+void Gui::render() const {
+    PROFILE_FUNCTION();
     // disable depth test and enable blend
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
 
-    // set default uniforms
-    glm::mat4 projection = glm::ortho(0.0f, width, height, 0.0f);
-    guiShader->setMatrix4("projection", projection);
-    guiShader->setBool("text", false);
-    guiShader->setBool("useTexture", false);
-    guiShader->setInt("tex", 0);
+    // the widgets only collect their quads, which are drawn at the end
+    renderer->begin(width, height);
 
     // render top menu
     if (!navigation.empty()) {
@@ -180,6 +189,8 @@ void Gui::render() const {
 
     warningWidget->render();
 
+    renderer->end();
+
     // enable depth test and disable blend
     glEnable(GL_DEPTH_TEST);
     glDisable(GL_BLEND);
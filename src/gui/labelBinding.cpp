@@ -0,0 +1,51 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gui/labelBinding.hpp"
+
+#include "gui/components/label.hpp"
+
+#include <algorithm>
+
+LabelBinding::LabelBinding(Label* label, float interval)
+    : label(label), interval(interval), elapsed(interval) {
+}
+
+void LabelBinding::update(float dt) {
+    elapsed += dt;
+
+    if (!changed || elapsed < interval) {
+        return;
+    }
+
+    elapsed = 0.0f;
+    changed = false;
+
+    const int formatted = format(formatBuffer.data(), bufferSize);
+    if (formatted < 0) {
+        return;
+    }
+
+    // the label is only changed if the text differs, so that the text is not laid out again
+    const size_t newLength = std::min(static_cast<size_t>(formatted), bufferSize - 1);
+    if (std::string_view(formatBuffer.data(), newLength) == std::string_view(buffer.data(), length)) {
+        return;
+    }
+
+    std::copy_n(formatBuffer.data(), newLength, buffer.data());
+    length = newLength;
+
+    label->setText(std::string_view(buffer.data(), length));
+}
@@ -24,15 +24,15 @@
 BuildMenu::BuildMenu(Gui* gui)
     : StackPanel("build_menu", gui, StackOrientation::COLUMN, colors::anthraziteGrey) {
 
-    constraints.width = AbsoluteConstraint(128);
-    constraints.x = RelativeConstraint(0.0f);
+    setWidth(AbsoluteConstraint(128));
+    setX(RelativeConstraint(0.0f));
     cornerRadius = 0;
     itemAligment = ItemAligment::BEGIN;
 
     /*liftTerrainButtonTexture = new Texture("res/gui/liftTerrain_icon.png");
     liftTerrainButton = new IconButton("build_menu.button_liftTerrain", gui, colors::anthraziteGrey, liftTerrainButtonTexture);
-    liftTerrainButton->constraints.width = AbsoluteConstraint(64);
-    liftTerrainButton->constraints.height = AbsoluteConstraint(64);
+    liftTerrainButton->setWidth(AbsoluteConstraint(64));
+    liftTerrainButton->setHeight(AbsoluteConstraint(64));
     liftTerrainButton->onClick += [&](MouseButtonEvent& e) {
         this->selectBuildingType(BuildingType::LIFT_TERRAIN);
 
@@ -42,8 +42,8 @@ BuildMenu::BuildMenu(Gui* gui)
 
     lowerTerrainButtonTexture = new Texture("res/gui/lowerTerrain_icon.png");
     lowerTerrainButton = new IconButton("build_menu.button_lowerTerrain", gui, colors::anthraziteGrey, lowerTerrainButtonTexture);
-    lowerTerrainButton->constraints.width = AbsoluteConstraint(64);
-    lowerTerrainButton->constraints.height = AbsoluteConstraint(64);
+    lowerTerrainButton->setWidth(AbsoluteConstraint(64));
+    lowerTerrainButton->setHeight(AbsoluteConstraint(64));
     lowerTerrainButton->onClick += [&](MouseButtonEvent& e) {
         this->selectBuildingType(BuildingType::LOWER_TERRAIN);
 
@@ -53,8 +53,8 @@ BuildMenu::BuildMenu(Gui* gui)
 
     streetButtonTexture = new Texture("res/gui/streetBuilder_icon.png");
     streetButton = new IconButton("build_menu.button_street", gui, colors::anthraziteGrey, streetButtonTexture);
-    streetButton->constraints.width = AbsoluteConstraint(64);
-    streetButton->constraints.height = AbsoluteConstraint(64);
+    streetButton->setWidth(AbsoluteConstraint(64));
+    streetButton->setHeight(AbsoluteConstraint(64));
     streetButton->onClick += [&](MouseButtonEvent& e) {
         this->selectBuildingType(BuildingType::ROAD);
 
@@ -64,8 +64,8 @@ BuildMenu::BuildMenu(Gui* gui)
 
     parkingLotButtonTexture = new Texture("res/gui/parking_lot_icon.png");
     parkingLotButton = new IconButton("build_menu.button_parkingLot", gui, colors::anthraziteGrey, parkingLotButtonTexture);
-    parkingLotButton->constraints.width = AbsoluteConstraint(64);
-    parkingLotButton->constraints.height = AbsoluteConstraint(64);
+    parkingLotButton->setWidth(AbsoluteConstraint(64));
+    parkingLotButton->setHeight(AbsoluteConstraint(64));
     parkingLotButton->onClick += [&](MouseButtonEvent& e) {
         this->selectBuildingType(BuildingType::PARKING_LOT);
 
@@ -21,48 +21,72 @@
 #include "application.hpp"
 
 #include "components/components.hpp"
-#include "misc/utility.hpp"
+
+#include <cstdio>
+#include <format>
 
 DebugPanel::DebugPanel(Gui* gui)
     : StackPanel("debug_menu", gui, StackOrientation::COLUMN, colors::anthraziteGrey, ItemAligment::BEGIN) {
-    constraints.x = AbsoluteConstraint(0);
-    constraints.y = AbsoluteConstraint(0);
-    constraints.width = RelativeConstraint(0.3);
-    constraints.height = RelativeConstraint(1.0);
+    setX(AbsoluteConstraint(0));
+    setY(AbsoluteConstraint(0));
+    setWidth(RelativeConstraint(0.3));
+    setHeight(RelativeConstraint(1.0));
     cornerRadius = 0.0f;
 
     TextButton* reloadResourcesButton = new TextButton("debug_menu.reloadResourcesButton", gui, colors::anthraziteGrey, "Reload Resources");
-    reloadResourcesButton->constraints.height = AbsoluteConstraint(30);
-    reloadResourcesButton->constraints.width = RelativeConstraint(0.9);
+    reloadResourcesButton->setHeight(AbsoluteConstraint(30));
+    reloadResourcesButton->setWidth(RelativeConstraint(0.9));
     reloadResourcesButton->onClick += [&](const MouseButtonEvent& e) {
         Application* app = this->gui->getApp();
         app->getGame()->reloadResources();
     };
     addChild(reloadResourcesButton);
 
-    Label* fpsCounter = new Label("debug_menu.fpsCounter", gui, colors::transparent, "FPS: ");
-    fpsCounter->textAlign = TextAlign::BEGIN;
-    fpsCounter->constraints.height = FitToContentConstraint();
-    fpsCounter->constraints.width = RelativeConstraint(0.9);
-    addChild(fpsCounter);
-
-    Label* sunDirection = new Label("debug_menu.sunDirection", gui, colors::transparent, "", 12);
-    sunDirection->textAlign = TextAlign::BEGIN;
-    sunDirection->constraints.height = FitToContentConstraint();
-    sunDirection->constraints.width = RelativeConstraint(0.9);
-    addChild(sunDirection);
-
-    Label* sunAngle = new Label("debug_menu.sunAngle", gui, colors::transparent, "", 12);
-    sunAngle->textAlign = TextAlign::BEGIN;
-    sunAngle->constraints.height = FitToContentConstraint();
-    sunAngle->constraints.width = RelativeConstraint(0.9);
-    addChild(sunAngle);
-
-    Label* cameraPos = new Label("debug_menu.cameraPosition", gui, colors::transparent, "", 12);
-    cameraPos->textAlign = TextAlign::BEGIN;
-    cameraPos->constraints.height = FitToContentConstraint();
-    cameraPos->constraints.width = RelativeConstraint(0.9);
-    addChild(cameraPos);
+    bind<float>("debug_menu.fpsCounter", fps, [](char* buffer, size_t size, float value) {
+        return std::snprintf(buffer, size, "FPS: %.0f", value);
+    }, 0.25f, 24);
+
+    bind<glm::vec3>("debug_menu.sunDirection", sunDirection, [](char* buffer, size_t size, const glm::vec3& value) {
+        return std::snprintf(buffer, size, "Sun direction: (x: %.3f y: %.3f z: %.3f)", value.x, value.y, value.z);
+    });
+
+    bind<float>("debug_menu.sunAngle", sunAngle, [](char* buffer, size_t size, float value) {
+        return std::snprintf(buffer, size, "Sun angle: %.2f", value);
+    });
+
+    bind<glm::vec3>("debug_menu.cameraPosition", cameraPosition, [](char* buffer, size_t size, const glm::vec3& value) {
+        return std::snprintf(buffer, size, "Camera position: (x: %.2f y: %.2f z: %.2f)", value.x, value.y, value.z);
+    });
+
+    bind<glm::vec4>("debug_menu.gpuTimes", gpuTimes, [](char* buffer, size_t size, const glm::vec4& value) {
+        return std::snprintf(buffer, size, "GPU: shadow %.2f ms scene %.2f ms debug %.2f ms gui %.2f ms", value.x, value.y, value.z, value.w);
+    }, 0.25f);
+
+    for (int i = 0; i < renderPassesCount; i++) {
+        bindRenderCounters(std::format("debug_menu.passCounters.{}", i), RenderStats::getPassName(static_cast<RenderPass>(i)), passCounters[i]);
+    }
+
+    for (int i = 0; i < RenderStats::categoriesCount; i++) {
+        bindRenderCounters(std::format("debug_menu.categoryCounters.{}", i), RenderStats::getCategoryName(static_cast<RenderCategory>(i)), categoryCounters[i]);
+    }
+}
+
+void DebugPanel::bindRenderCounters(const std::string& id, const char* name, Observable<RenderCounters>& observable) {
+    bind<RenderCounters>(id, observable, [name](char* buffer, size_t size, const RenderCounters& value) {
+        return std::snprintf(buffer, size, "%s: %u draws, %u inst, %llu tris, %u prog, %u tex, %u unif, %u vao, %.1f KB",
+                             name, value.drawCalls, value.instances, static_cast<unsigned long long>(value.triangles), value.programSwitches,
+                             value.textureBinds, value.uniformSets, value.vaoBinds, value.uploadBytes / 1024.0);
+    }, 0.25f, 10);
+}
+
+Label* DebugPanel::addValueLabel(const std::string& id, int textSize) {
+    Label* label = new Label(id, gui, colors::transparent, "", textSize);
+    label->textAlign = TextAlign::BEGIN;
+    label->setHeight(FitToContentConstraint());
+    label->setWidth(RelativeConstraint(0.9));
+    addChild(label);
+
+    return label;
 }
 
 void DebugPanel::update() {
@@ -70,24 +94,34 @@ void DebugPanel::update() {
     Game* game = app->getGame();
     const entt::registry& registry = game->getRegistry();
 
-    // fps
-    float fps = 1.0f / app->updateTime;
+    // the observables only notify the bindings if the values changed
+    fps.set(1.0f / app->updateTime);
 
-    Label* fpsCounter = dynamic_cast<Label*>(getChild("debug_menu.fpsCounter"));
-    fpsCounter->text = "FPS: " + std::to_string(fps);
-
-    // sun info
     const SunLightComponent& sunLight = registry.get<SunLightComponent>(game->sun);
-    const TransformationComponent& sunTransform = registry.get<TransformationComponent>(game->sun);
-
-    Label* sunDirection = dynamic_cast<Label*>(getChild("debug_menu.sunDirection"));
-    sunDirection->text = "Sun direction: (" + std::to_string(sunLight.direction) + ")";
-    Label* sunAngle = dynamic_cast<Label*>(getChild("debug_menu.sunAngle"));
-    sunAngle->text = "Sun angle: " + std::to_string(glm::degrees(sunLight.angle));
+    sunDirection.set(sunLight.direction);
+    sunAngle.set(glm::degrees(sunLight.angle));
 
-    // camera info
     const TransformationComponent& cameraTransform = registry.get<TransformationComponent>(game->camera);
+    cameraPosition.set(cameraTransform.position);
+
+    const GpuTimer* gpuTimer = app->getGpuTimer();
+    const RenderStats& renderStats = RenderStats::get();
+    for (int i = 0; i < renderPassesCount; i++) {
+        passCounters[i].set(renderStats.getPassCounters(static_cast<RenderPass>(i)));
+    }
+
+    for (int i = 0; i < RenderStats::categoriesCount; i++) {
+        categoryCounters[i].set(renderStats.getCategoryCounters(static_cast<RenderCategory>(i)));
+    }
+
+    gpuTimes.set(glm::vec4(gpuTimer->getTime(RenderPass::SHADOW), gpuTimer->getTime(RenderPass::SCENE), gpuTimer->getTime(RenderPass::DEBUG), gpuTimer->getTime(RenderPass::GUI)));
+
+    // the labels are formatted only while the panel is visible
+    if (!visible) {
+        return;
+    }
 
-    Label* cameraPosition = dynamic_cast<Label*>(getChild("debug_menu.cameraPosition"));
-    cameraPosition->text = "Camera position: (" + std::to_string(cameraTransform.position) + ")";
+    for (const auto& binding : bindings) {
+        binding->update(app->updateTime);
+    }
 }
@@ -23,12 +23,12 @@
 PauseMenu::PauseMenu(Gui* gui)
     : StackPanel("game_menu", gui, StackOrientation::COLUMN, colors::transparent) {
 
-    constraints.width = RelativeConstraint(0.6f);
-    constraints.height = AbsoluteConstraint(195.0f);
+    setWidth(RelativeConstraint(0.6f));
+    setHeight(AbsoluteConstraint(195.0f));
 
     TextButton* _continue = new TextButton("mainMenu_continue", gui, colors::anthraziteGrey, "Back to game");
-    _continue->constraints.height = AbsoluteConstraint(45.0f);
-    _continue->constraints.width = RelativeConstraint(0.9f);
+    _continue->setHeight(AbsoluteConstraint(45.0f));
+    _continue->setWidth(RelativeConstraint(0.9f));
     _continue->onClick += [&](const MouseButtonEvent& e) {
         this->onResumeButtonClick(e);
     };
@@ -36,8 +36,8 @@ PauseMenu::PauseMenu(Gui* gui)
     addChild(_continue);
 
     TextButton* options = new TextButton("mainMenu_options", gui, colors::anthraziteGrey, "Options");
-    options->constraints.height = AbsoluteConstraint(45.0f);
-    options->constraints.width = RelativeConstraint(0.9f);
+    options->setHeight(AbsoluteConstraint(45.0f));
+    options->setWidth(RelativeConstraint(0.9f));
     options->onClick += [&](const MouseButtonEvent& e) {
         this->onOptionsButtonClick(e);
     };
@@ -45,8 +45,8 @@ PauseMenu::PauseMenu(Gui* gui)
     addChild(options);
 
     TextButton* saveAndExit = new TextButton("mainMenu_saveExit", gui, colors::anthraziteGrey, "Save and Exit");
-    saveAndExit->constraints.height = AbsoluteConstraint(45.0f);
-    saveAndExit->constraints.width = RelativeConstraint(0.9f);
+    saveAndExit->setHeight(AbsoluteConstraint(45.0f));
+    saveAndExit->setWidth(RelativeConstraint(0.9f));
     saveAndExit->onClick += [&](const MouseButtonEvent& e) {
         this->onExitButtonClick(e);
     };
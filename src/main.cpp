@@ -13,12 +13,86 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
 #include "application.hpp"
+#include "misc/profiler.hpp"
+#include "rendering/renderStats.hpp"
 
-int main(int, char**) {
-    Application app;
+int main(int argc, char** argv) {
+    ApplicationOptions options;
+
+    // --trace <file> writes the profiling zones when the game is closed
+    std::string traceFilename;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "--trace" && i + 1 < argc) {
+            traceFilename = argv[++i];
+        }
+        // --stats <file> writes the render statistics of every frame
+        else if (argument == "--stats" && i + 1 < argc) {
+            RenderStats::get().openCsv(argv[++i]);
+        }
+        // --headless renders offscreen without a display
+        else if (argument == "--headless") {
+            options.headless = true;
+        }
+        // --size <width>x<height> sets the size of the offscreen framebuffer
+        else if (argument == "--size" && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                std::cerr << "--size expects <width>x<height>" << std::endl;
+                return 1;
+            }
+        }
+        // --benchmark <frames> renders the frames along the camera path and reports the frame times
+        else if (argument == "--benchmark" && i + 1 < argc) {
+            options.benchmarkFrames = std::atoi(argv[++i]);
+        }
+        // --camera-path <file> plays a recorded camera path as benchmark
+        else if (argument == "--camera-path" && i + 1 < argc) {
+            options.cameraPath = argv[++i];
+        }
+        // --report <file> writes the benchmark report into the file
+        else if (argument == "--report" && i + 1 < argc) {
+            options.benchmarkReport = argv[++i];
+        }
+        // --budget <ms> sets the frame time above which benchmark frames are counted as hitches
+        else if (argument == "--budget" && i + 1 < argc) {
+            options.frameBudget = std::atof(argv[++i]);
+        }
+        // --seed <seed> sets the seed of the world generation
+        else if (argument == "--seed" && i + 1 < argc) {
+            options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        // --validate-systems checks the declared component access of the systems
+        else if (argument == "--validate-systems") {
+#if DEBUG
+            options.validateSystems = true;
+#else
+            std::cerr << "--validate-systems requires a debug build" << std::endl;
+#endif
+        }
+    }
+
+#ifdef PROFILING
+    Profiler::get().setThreadName("main");
+#else
+    if (!traceFilename.empty()) {
+        std::cerr << "--trace requires a build with PROFILING enabled" << std::endl;
+    }
+#endif
+
+    Application app(options);
 
     app.run();
+
+#ifdef PROFILING
+    if (!traceFilename.empty()) {
+        Profiler::get().writeTrace(traceFilename);
+    }
+#endif
 }
@@ -0,0 +1,193 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/benchmark.hpp"
+
+#include "events/chunkEvents.hpp"
+#include "misc/configuration.hpp"
+#include "rendering/gpuTimer.hpp"
+#include "rendering/renderStats.hpp"
+#include "systems/cameraSystem.hpp"
+
+#include "application.hpp"
+#include "game.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+Benchmark::Benchmark(Game* game, const ApplicationOptions& options)
+    : game(game), frames(options.benchmarkFrames), frameBudget(options.frameBudget), reportFilename(options.benchmarkReport) {
+    if (options.cameraPath.empty() || !path.load(options.cameraPath)) {
+        path = createDefaultPath();
+    }
+
+    game->getEventDispatcher().sink<EventBatch<ChunkCreatedEvent>>().connect<&Benchmark::onChunksCreated>(*this);
+}
+
+CameraPath Benchmark::createDefaultPath() {
+    CameraPath path;
+
+    const glm::vec2 direction = glm::normalize(glm::vec2(1.0f, 0.5f));
+    for (float time = 0.0f; time <= defaultPathDuration; time += 5.0f) {
+        const glm::vec2 position = direction * (defaultPathSpeed * time);
+        path.addKeyframe(CameraKeyframe{time, glm::vec3(position.x, Configuration::cameraHeight, position.y), 15.0f * time, -20.0f});
+    }
+
+    return path;
+}
+
+bool Benchmark::finished() const {
+    if (frames > 0) {
+        return frame >= warmupFrames + frames;
+    }
+
+    return frame > warmupFrames && !game->getCameraSystem()->isPlaying();
+}
+
+void Benchmark::onChunksCreated(const EventBatch<ChunkCreatedEvent>& batch) {
+    for (const ChunkCreatedEvent& e : batch.events) {
+        frameChunksStreamed++;
+        frameChunkLatency = std::max(frameChunkLatency, e.streamingLatency * 1000.0f);
+
+        if (frame >= warmupFrames) {
+            chunkLatencies.push_back(e.streamingLatency * 1000.0f);
+        }
+    }
+}
+
+void Benchmark::recordFrame(float cpuTime, const GpuTimer& gpuTimer) {
+    frame++;
+
+    if (frame == warmupFrames) {
+        game->getCameraSystem()->playPath(path);
+    }
+
+    if (frame > warmupFrames) {
+        records.push_back(FrameRecord{cpuTime * 1000.0f, {}, frameChunksStreamed, frameChunkLatency});
+    }
+
+    // the gpu times were measured `GpuTimer::latency` frames ago, so they are stored with the record of that frame
+    const int measuredRecord = frame - GpuTimer::latency - warmupFrames - 1;
+    if (measuredRecord >= 0 && measuredRecord < static_cast<int>(records.size())) {
+        FrameRecord& record = records[measuredRecord];
+        for (int pass = 0; pass < renderPassesCount; pass++) {
+            record.gpuTimes[pass] = gpuTimer.getTime(static_cast<RenderPass>(pass));
+            record.gpuMeasured[pass] = gpuTimer.isValid(static_cast<RenderPass>(pass));
+        }
+    }
+
+    frameChunksStreamed = 0;
+    frameChunkLatency = 0.0f;
+}
+
+float Benchmark::percentile(std::vector<float> values, float p) {
+    if (values.empty()) {
+        return 0.0f;
+    }
+
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0f * values.size()));
+    const size_t index = std::clamp<size_t>(rank, 1, values.size()) - 1;
+
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void Benchmark::writeReport() const {
+    std::stringstream summary;
+    summary << "metric,value\n";
+    summary << "frames," << records.size() << '\n';
+
+    const auto writePercentiles = [&](const std::string& name, const std::vector<float>& values) {
+        for (float p : {50.0f, 90.0f, 99.0f, 100.0f}) {
+            summary << name << "_p" << p << "_ms," << percentile(values, p) << '\n';
+        }
+    };
+
+    std::vector<float> cpuTimes;
+    std::transform(records.begin(), records.end(), std::back_inserter(cpuTimes), [](const FrameRecord& record) { return record.cpuTime; });
+    writePercentiles("cpu_frame", cpuTimes);
+
+    for (int pass = 0; pass < renderPassesCount; pass++) {
+        std::vector<float> gpuTimes;
+        for (const FrameRecord& record : records) {
+            if (record.gpuMeasured[pass]) {
+                gpuTimes.push_back(record.gpuTimes[pass]);
+            }
+        }
+
+        // passes that were not rendered are skipped
+        if (gpuTimes.empty()) {
+            continue;
+        }
+
+        writePercentiles(std::string("gpu_") + RenderStats::getPassName(static_cast<RenderPass>(pass)), gpuTimes);
+    }
+
+    summary << "chunks_streamed," << chunkLatencies.size() << '\n';
+    writePercentiles("chunk_latency", chunkLatencies);
+
+    const auto hitches = std::count_if(records.begin(), records.end(), [this](const FrameRecord& record) { return record.cpuTime > frameBudget; });
+    summary << "frame_budget_ms," << frameBudget << '\n';
+    summary << "hitches," << hitches << '\n';
+
+    std::cout << "BENCHMARK:\n" << summary.str() << std::flush;
+
+    if (reportFilename.empty()) {
+        return;
+    }
+
+    std::ofstream stream(reportFilename);
+    if (!stream.is_open()) {
+        std::cerr << "BENCHMARK: Failed to open " << reportFilename << std::endl;
+        return;
+    }
+
+    stream << summary.str();
+
+    // the times of every frame are written next to the summary
+    std::filesystem::path framesFilename = reportFilename;
+    framesFilename.replace_extension(".frames.csv");
+
+    std::ofstream framesStream(framesFilename);
+    if (!framesStream.is_open()) {
+        std::cerr << "BENCHMARK: Failed to open " << framesFilename << std::endl;
+        return;
+    }
+
+    framesStream << "frame,cpu_ms";
+    for (int pass = 0; pass < renderPassesCount; pass++) {
+        framesStream << ",gpu_" << RenderStats::getPassName(static_cast<RenderPass>(pass)) << "_ms";
+    }
+    framesStream << ",chunks_streamed,chunk_latency_ms,hitch\n";
+
+    for (size_t i = 0; i < records.size(); i++) {
+        const FrameRecord& record = records[i];
+
+        framesStream << i << ',' << record.cpuTime;
+        for (int pass = 0; pass < renderPassesCount; pass++) {
+            // passes whose gpu times were not available or not read back before the end have empty columns
+            framesStream << ',';
+            if (record.gpuMeasured[pass]) {
+                framesStream << record.gpuTimes[pass];
+            }
+        }
+        framesStream << ',' << record.chunksStreamed << ',' << record.chunkLatency << ',' << (record.cpuTime > frameBudget ? 1 : 0) << '\n';
+    }
+}
@@ -0,0 +1,114 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/cameraPath.hpp"
+
+#include <glm/gtx/spline.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool CameraPath::load(const std::string& filename) {
+    std::ifstream stream(filename);
+    if (!stream.is_open()) {
+        std::cerr << "CAMERA_PATH: Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    keyframes.clear();
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream lineStream(line);
+        CameraKeyframe keyframe;
+        if (!(lineStream >> keyframe.time >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z >> keyframe.yaw >> keyframe.pitch)) {
+            std::cerr << "CAMERA_PATH: Invalid keyframe \"" << line << "\" in " << filename << std::endl;
+            continue;
+        }
+
+        keyframes.push_back(keyframe);
+    }
+
+    std::sort(keyframes.begin(), keyframes.end(), [](const CameraKeyframe& a, const CameraKeyframe& b) {
+        return a.time < b.time;
+    });
+
+    return !keyframes.empty();
+}
+
+bool CameraPath::save(const std::string& filename) const {
+    std::ofstream stream(filename);
+    if (!stream.is_open()) {
+        std::cerr << "CAMERA_PATH: Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    stream << "# time x y z yaw pitch\n";
+    for (const CameraKeyframe& keyframe : keyframes) {
+        stream << keyframe.time << ' ' << keyframe.position.x << ' ' << keyframe.position.y << ' ' << keyframe.position.z << ' ' << keyframe.yaw << ' ' << keyframe.pitch << '\n';
+    }
+
+    return true;
+}
+
+void CameraPath::addKeyframe(const CameraKeyframe& keyframe) {
+    keyframes.push_back(keyframe);
+}
+
+void CameraPath::clear() {
+    keyframes.clear();
+}
+
+float CameraPath::getDuration() const {
+    return keyframes.empty() ? 0.0f : keyframes.back().time;
+}
+
+CameraKeyframe CameraPath::sample(float time) const {
+    if (keyframes.empty()) {
+        return CameraKeyframe{time, glm::vec3(0.0f), 0.0f, 0.0f};
+    }
+
+    if (time <= keyframes.front().time) {
+        return keyframes.front();
+    }
+
+    if (time >= keyframes.back().time) {
+        return keyframes.back();
+    }
+
+    // the keyframe after the time
+    const auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time, [](float time, const CameraKeyframe& keyframe) {
+        return time < keyframe.time;
+    });
+
+    const size_t i = std::distance(keyframes.begin(), next) - 1;
+    const CameraKeyframe& k0 = keyframes[i > 0 ? i - 1 : i];
+    const CameraKeyframe& k1 = keyframes[i];
+    const CameraKeyframe& k2 = keyframes[i + 1];
+    const CameraKeyframe& k3 = keyframes[std::min(i + 2, keyframes.size() - 1)];
+
+    const float s = (time - k1.time) / (k2.time - k1.time);
+
+    const glm::vec3 position = glm::catmullRom(k0.position, k1.position, k2.position, k3.position, s);
+    const glm::vec2 angles = glm::catmullRom(glm::vec2(k0.yaw, k0.pitch), glm::vec2(k1.yaw, k1.pitch), glm::vec2(k2.yaw, k2.pitch), glm::vec2(k3.yaw, k3.pitch), s);
+
+    return CameraKeyframe{time, position, angles.x, angles.y};
+}
@@ -0,0 +1,113 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/frustum.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FRUSTUM_USE_SSE 1
+#endif
+
+void BoundingSpheres::clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+}
+
+void BoundingSpheres::reserve(size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+    radius.reserve(count);
+}
+
+void BoundingSpheres::push_back(const glm::vec3& center, float r) {
+    x.push_back(center.x);
+    y.push_back(center.y);
+    z.push_back(center.z);
+    radius.push_back(r);
+}
+
+size_t BoundingSpheres::size() const {
+    return radius.size();
+}
+
+Frustum::Frustum(const glm::mat4& m) {
+    // glm matrices are column major, so the rows have to be assembled first
+    const glm::vec4 rows[4] = {
+        glm::vec4(m[0][0], m[1][0], m[2][0], m[3][0]),
+        glm::vec4(m[0][1], m[1][1], m[2][1], m[3][1]),
+        glm::vec4(m[0][2], m[1][2], m[2][2], m[3][2]),
+        glm::vec4(m[0][3], m[1][3], m[2][3], m[3][3]),
+    };
+
+    planes[0] = rows[3] + rows[0];
+    planes[1] = rows[3] - rows[0];
+    planes[2] = rows[3] + rows[1];
+    planes[3] = rows[3] - rows[1];
+    planes[4] = rows[3] + rows[2];
+    planes[5] = rows[3] - rows[2];
+
+    for (glm::vec4& plane : planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+}
+
+bool Frustum::intersects(const glm::vec3& center, float radius) const {
+    for (const glm::vec4& plane : planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Frustum::testSpheres(const BoundingSpheres& spheres, std::vector<unsigned char>& visible, bool combine) const {
+    const size_t count = spheres.size();
+    size_t i = 0;
+
+#if FRUSTUM_USE_SSE
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(spheres.x.data() + i);
+        const __m128 y = _mm_loadu_ps(spheres.y.data() + i);
+        const __m128 z = _mm_loadu_ps(spheres.z.data() + i);
+        const __m128 negativeRadius = _mm_sub_ps(zero, _mm_loadu_ps(spheres.radius.data() + i));
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (const glm::vec4& plane : planes) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), x), _mm_mul_ps(_mm_set1_ps(plane.y), y));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), z));
+            distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (int j = 0; j < 4; j++) {
+            const unsigned char value = (mask >> j) & 1;
+            visible[i + j] = combine ? (visible[i + j] | value) : value;
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        const unsigned char value = intersects(glm::vec3(spheres.x[i], spheres.y[i], spheres.z[i]), spheres.radius[i]);
+        visible[i] = combine ? (visible[i] | value) : value;
+    }
+}
@@ -0,0 +1,199 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/jobSystem.hpp"
+
+#include "misc/profiler.hpp"
+
+#include <string>
+
+/// @brief Index of the queue owned by the calling thread. Threads outside of the pool use the shared queue
+static thread_local int currentQueue = -1;
+
+JobSystem::JobSystem() {
+    // the main thread helps while it waits, so one core is left for it
+    const unsigned int cores = std::thread::hardware_concurrency();
+    const unsigned int workersCount = cores > 1 ? cores - 1 : 1;
+
+    for (unsigned int i = 0; i <= workersCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (unsigned int i = 0; i < workersCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+JobSystem& JobSystem::get() {
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+void JobSystem::workerLoop(unsigned int index) {
+    currentQueue = index;
+#ifdef PROFILING
+    Profiler::get().setThreadName("worker " + std::to_string(index));
+#endif
+
+    while (running) {
+        if (runJob(JobPriority::LOW)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this]() {
+            return queuedJobs.load(std::memory_order_acquire) > 0 || !running;
+        });
+    }
+}
+
+void JobSystem::submit(std::function<void()> function, JobCounter* counter, JobPriority priority, JobCounter* dependency) {
+    if (counter) {
+        counter->count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job job{std::move(function), counter, priority};
+
+    if (dependency) {
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+
+        // the job is scheduled by the last job of the dependency
+        if (!dependency->done()) {
+            dependency->continuations.push_back(std::move(job));
+            return;
+        }
+    }
+
+    schedule(std::move(job));
+}
+
+void JobSystem::schedule(Job&& job) {
+    const unsigned int queueIndex = currentQueue >= 0 ? currentQueue : queues.size() - 1;
+    WorkerQueue& queue = *queues[queueIndex];
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs[static_cast<unsigned int>(job.priority)].push_back(std::move(job));
+    }
+
+    // the sleep mutex is acquired, so that a worker can not miss the notification between checking the condition and going to sleep
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeCondition.notify_one();
+}
+
+bool JobSystem::takeJob(JobPriority priority, Job& job) {
+    const unsigned int priorityIndex = static_cast<unsigned int>(priority);
+    const unsigned int queuesCount = queues.size();
+
+    // the own queue is used as a stack, so that the data of recently submitted jobs is still in the cache
+    if (currentQueue >= 0) {
+        WorkerQueue& queue = *queues[currentQueue];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        std::deque<Job>& jobs = queue.jobs[priorityIndex];
+        if (!jobs.empty()) {
+            job = std::move(jobs.back());
+            jobs.pop_back();
+            return true;
+        }
+    }
+
+    // steal the oldest job of another queue, starting with the neighbour to spread the threads over the queues
+    const unsigned int start = currentQueue >= 0 ? currentQueue + 1 : 0;
+    for (unsigned int i = 0; i < queuesCount; i++) {
+        const unsigned int index = (start + i) % queuesCount;
+        if (static_cast<int>(index) == currentQueue) {
+            continue;
+        }
+
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        std::deque<Job>& jobs = queue.jobs[priorityIndex];
+        if (!jobs.empty()) {
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JobSystem::runJob(JobPriority minPriority) {
+    if (queuedJobs.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    Job job;
+    for (unsigned int priority = 0; priority <= static_cast<unsigned int>(minPriority); priority++) {
+        if (takeJob(static_cast<JobPriority>(priority), job)) {
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+            job.function();
+            finishJob(job);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::finishJob(const Job& job) {
+    JobCounter* counter = job.counter;
+    if (!counter) {
+        return;
+    }
+
+    // the counter is changed while its mutex is locked, so that a waiting thread can not destroy it before the mutex is released
+    std::vector<Job> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+
+        if (counter->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            continuations.swap(counter->continuations);
+        }
+    }
+
+    for (Job& continuation : continuations) {
+        schedule(std::move(continuation));
+    }
+}
+
+void JobSystem::wait(const JobCounter& counter, JobPriority helpPriority) {
+    while (!counter.done()) {
+        if (!runJob(helpPriority)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // the last job may still hold the mutex of the counter
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
@@ -0,0 +1,292 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/occlusionBuffer.hpp"
+
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define OCCLUSION_USE_SSE 1
+#endif
+
+OcclusionBuffer::OcclusionBuffer()
+    : depth(width * height, 1.0f) {
+}
+
+void OcclusionBuffer::clear(const glm::mat4& viewProjection) {
+    this->viewProjection = viewProjection;
+
+    std::fill(depth.begin(), depth.end(), 1.0f);
+    triangles.clear();
+}
+
+void OcclusionBuffer::addOccluder(const std::vector<glm::vec3>& triangles, const glm::mat4& model) {
+    const glm::mat4 modelViewProjection = viewProjection * model;
+
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+        addClippedTriangle({
+            modelViewProjection * glm::vec4(triangles[i], 1.0f),
+            modelViewProjection * glm::vec4(triangles[i + 1], 1.0f),
+            modelViewProjection * glm::vec4(triangles[i + 2], 1.0f),
+        });
+    }
+}
+
+void OcclusionBuffer::addClippedTriangle(const std::array<glm::vec4, 3>& vertices) {
+    // reject triangles that are completely outside of one of the clipping planes
+    for (int axis = 0; axis < 3; axis++) {
+        if (vertices[0][axis] > vertices[0].w && vertices[1][axis] > vertices[1].w && vertices[2][axis] > vertices[2].w) {
+            return;
+        }
+
+        if (axis < 2 && vertices[0][axis] < -vertices[0].w && vertices[1][axis] < -vertices[1].w && vertices[2][axis] < -vertices[2].w) {
+            return;
+        }
+    }
+
+    // distances to the near plane
+    const std::array<float, 3> distances = {
+        vertices[0].z + vertices[0].w,
+        vertices[1].z + vertices[1].w,
+        vertices[2].z + vertices[2].w,
+    };
+
+    if (distances[0] >= 0.0f && distances[1] >= 0.0f && distances[2] >= 0.0f) {
+        addScreenTriangle(vertices[0], vertices[1], vertices[2]);
+        return;
+    }
+
+    // clip the triangle at the near plane, which results in at most four vertices
+    std::array<glm::vec4, 4> polygon;
+    int count = 0;
+    for (int i = 0; i < 3; i++) {
+        const int j = (i + 1) % 3;
+
+        if (distances[i] >= 0.0f) {
+            polygon[count++] = vertices[i];
+        }
+
+        if ((distances[i] >= 0.0f) != (distances[j] >= 0.0f)) {
+            const float t = distances[i] / (distances[i] - distances[j]);
+            polygon[count++] = glm::mix(vertices[i], vertices[j], t);
+        }
+    }
+
+    for (int i = 1; i + 1 < count; i++) {
+        addScreenTriangle(polygon[0], polygon[i], polygon[i + 1]);
+    }
+}
+
+void OcclusionBuffer::addScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) {
+    ScreenTriangle triangle;
+
+    const glm::vec4* clipVertices[3] = {&a, &b, &c};
+    for (int i = 0; i < 3; i++) {
+        const glm::vec4& vertex = *clipVertices[i];
+        if (vertex.w <= 0.0f) {
+            return;
+        }
+
+        const glm::vec3 ndc = glm::vec3(vertex) / vertex.w;
+        triangle.vertices[i] = glm::vec3((0.5f * ndc.x + 0.5f) * width, (0.5f * ndc.y + 0.5f) * height, ndc.z);
+    }
+
+    const float minX = glm::min(triangle.vertices[0].x, glm::min(triangle.vertices[1].x, triangle.vertices[2].x));
+    const float maxX = glm::max(triangle.vertices[0].x, glm::max(triangle.vertices[1].x, triangle.vertices[2].x));
+    const float minY = glm::min(triangle.vertices[0].y, glm::min(triangle.vertices[1].y, triangle.vertices[2].y));
+    const float maxY = glm::max(triangle.vertices[0].y, glm::max(triangle.vertices[1].y, triangle.vertices[2].y));
+
+    if (maxX < 0.0f || minX > width || maxY < 0.0f || minY > height) {
+        return;
+    }
+
+    triangle.minY = glm::max(0, static_cast<int>(glm::floor(minY)));
+    triangle.maxY = glm::min(height - 1, static_cast<int>(glm::floor(maxY)));
+
+    triangles.push_back(triangle);
+}
+
+void OcclusionBuffer::rasterize() {
+    constexpr int bandsCount = Configuration::occlusionBands;
+    constexpr int rowsPerBand = (height + bandsCount - 1) / bandsCount;
+
+    // the bands do not overlap, so no synchronization is needed
+    JobSystem::get().parallelFor(0, bandsCount, 1, [this](std::size_t first, std::size_t last) {
+        for (int band = first; band < last; band++) {
+            rasterizeRows(band * rowsPerBand, glm::min(height - 1, (band + 1) * rowsPerBand - 1));
+        }
+    });
+}
+
+void OcclusionBuffer::rasterizeRows(int minRow, int maxRow) {
+    PROFILE_FUNCTION();
+    for (const ScreenTriangle& triangle : triangles) {
+        if (triangle.maxY >= minRow && triangle.minY <= maxRow) {
+            rasterizeTriangle(triangle, minRow, maxRow);
+        }
+    }
+}
+
+void OcclusionBuffer::rasterizeTriangle(const ScreenTriangle& triangle, int minRow, int maxRow) {
+    glm::vec3 a = triangle.vertices[0];
+    glm::vec3 b = triangle.vertices[1];
+    glm::vec3 c = triangle.vertices[2];
+
+    // occluders are rendered double sided, so the winding is made counter clockwise
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (area == 0.0f) {
+        return;
+    }
+
+    if (area < 0.0f) {
+        std::swap(b, c);
+        area = -area;
+    }
+
+    // edge functions e(x, y) = A * x + B * y + C, which are positive inside of the triangle
+    const glm::vec3 edgeStarts[3] = {a, b, c};
+    const glm::vec3 edgeEnds[3] = {b, c, a};
+    float edgeA[3], edgeB[3], edgeC[3];
+    for (int i = 0; i < 3; i++) {
+        edgeA[i] = edgeStarts[i].y - edgeEnds[i].y;
+        edgeB[i] = edgeEnds[i].x - edgeStarts[i].x;
+        edgeC[i] = -(edgeA[i] * edgeStarts[i].x + edgeB[i] * edgeStarts[i].y);
+    }
+
+    // depth plane z(x, y) = z0 + dzdx * x + dzdy * y
+    const float dzdx = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+    const float dzdy = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+    const float z0 = a.z - dzdx * a.x - dzdy * a.y;
+
+    const int minX = glm::max(0, static_cast<int>(glm::floor(glm::min(a.x, glm::min(b.x, c.x))))) & ~3;
+    const int maxX = glm::min(width - 1, static_cast<int>(glm::floor(glm::max(a.x, glm::max(b.x, c.x)))));
+    const int minY = glm::max(minRow, triangle.minY);
+    const int maxY = glm::min(maxRow, triangle.maxY);
+
+    for (int y = minY; y <= maxY; y++) {
+        const float py = y + 0.5f;
+        float* row = depth.data() + y * width;
+
+        float rowEdges[3];
+        for (int i = 0; i < 3; i++) {
+            rowEdges[i] = edgeB[i] * py + edgeC[i];
+        }
+        const float rowDepth = z0 + dzdy * py;
+
+#if OCCLUSION_USE_SSE
+        // the width is a multiple of four, so blocks starting at an aligned x never leave the row
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+
+        for (int x = minX; x <= maxX; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+
+            __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[0]), px), _mm_set1_ps(rowEdges[0])), zero);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[1]), px), _mm_set1_ps(rowEdges[1])), zero));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[2]), px), _mm_set1_ps(rowEdges[2])), zero));
+
+            if (_mm_movemask_ps(inside) == 0) {
+                continue;
+            }
+
+            const __m128 z = _mm_add_ps(_mm_set1_ps(rowDepth), _mm_mul_ps(_mm_set1_ps(dzdx), px));
+            const __m128 current = _mm_loadu_ps(row + x);
+            const __m128 nearest = _mm_min_ps(current, z);
+
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+        }
+#else
+        for (int x = minX; x <= maxX; x++) {
+            const float px = x + 0.5f;
+
+            if (edgeA[0] * px + rowEdges[0] >= 0.0f && edgeA[1] * px + rowEdges[1] >= 0.0f && edgeA[2] * px + rowEdges[2] >= 0.0f) {
+                row[x] = glm::min(row[x], rowDepth + dzdx * px);
+            }
+        }
+#endif
+    }
+}
+
+bool OcclusionBuffer::isOccluded(const glm::vec3& min, const glm::vec3& max) const {
+    glm::vec2 screenMin = glm::vec2(std::numeric_limits<float>::max());
+    glm::vec2 screenMax = glm::vec2(std::numeric_limits<float>::lowest());
+    float nearestDepth = std::numeric_limits<float>::max();
+
+    for (int i = 0; i < 8; i++) {
+        const glm::vec3 corner = glm::vec3(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z);
+        const glm::vec4 clip = viewProjection * glm::vec4(corner, 1.0f);
+
+        // boxes that intersect the near plane are always visible
+        if (clip.w <= 0.0f || clip.z < -clip.w) {
+            return false;
+        }
+
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        const glm::vec2 screen = glm::vec2((0.5f * ndc.x + 0.5f) * width, (0.5f * ndc.y + 0.5f) * height);
+
+        screenMin = glm::min(screenMin, screen);
+        screenMax = glm::max(screenMax, screen);
+        nearestDepth = glm::min(nearestDepth, ndc.z);
+    }
+
+    // boxes outside of the screen are left to the frustum culling
+    if (screenMax.x < 0.0f || screenMin.x > width || screenMax.y < 0.0f || screenMin.y > height) {
+        return false;
+    }
+
+    const int minX = glm::max(0, static_cast<int>(glm::floor(screenMin.x)));
+    const int maxX = glm::min(width - 1, static_cast<int>(glm::floor(screenMax.x)));
+    const int minY = glm::max(0, static_cast<int>(glm::floor(screenMin.y)));
+    const int maxY = glm::min(height - 1, static_cast<int>(glm::floor(screenMax.y)));
+
+    for (int y = minY; y <= maxY; y++) {
+        const float* row = depth.data() + y * width;
+        int x = minX;
+
+#if OCCLUSION_USE_SSE
+        const __m128 boxDepth = _mm_set1_ps(nearestDepth);
+        for (; x + 3 <= maxX; x += 4) {
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), boxDepth)) != 0) {
+                return false;
+            }
+        }
+#endif
+
+        for (; x <= maxX; x++) {
+            if (row[x] >= nearestDepth) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool OcclusionBuffer::isOccluded(const glm::vec3& center, float radius) const {
+    return isOccluded(center - glm::vec3(radius), center + glm::vec3(radius));
+}
+
+const std::vector<float>& OcclusionBuffer::getDepth() const {
+    return depth;
+}
+
+unsigned int OcclusionBuffer::getTrianglesCount() const {
+    return triangles.size();
+}
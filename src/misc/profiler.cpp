@@ -0,0 +1,119 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+Profiler& Profiler::get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+    // the buffer is shared with the profiler, so that the events stay available after the thread ended
+    thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+
+    if (!threadBuffer) {
+        threadBuffer = std::make_shared<ThreadBuffer>();
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        threadBuffer->id = buffers.size();
+        threadBuffer->name = "thread " + std::to_string(threadBuffer->id);
+        buffers.push_back(threadBuffer);
+    }
+
+    return *threadBuffer;
+}
+
+void Profiler::recordGpu(const char* name, int64_t start, int64_t end) {
+    if (!gpuBuffer) {
+        gpuBuffer = std::make_shared<ThreadBuffer>();
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        gpuBuffer->id = buffers.size();
+        gpuBuffer->name = "GPU";
+        buffers.push_back(gpuBuffer);
+    }
+
+    record(*gpuBuffer, name, start, end);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffer.name = name;
+}
+
+/// @brief Escapes the characters of a zone name that are not allowed in JSON strings
+static void writeJsonString(std::ofstream& stream, const std::string& text) {
+    stream << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            stream << '\\';
+        }
+        stream << c;
+    }
+    stream << '"';
+}
+
+bool Profiler::writeTrace(const std::string& filename) const {
+    std::ofstream stream(filename);
+    if (!stream.is_open()) {
+        std::cerr << "PROFILER: Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    // the timestamps are written in microseconds
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"traceEvents\":[";
+
+    bool first = true;
+    for (const auto& buffer : buffers) {
+        if (!first) {
+            stream << ",";
+        }
+        first = false;
+
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+        writeJsonString(stream, buffer->name);
+        stream << "}}";
+
+        // the oldest events may be overwritten while they are written, so they are skipped
+        const size_t end = buffer->count.load(std::memory_order_acquire);
+        const size_t margin = eventsPerThread / 8;
+        const size_t begin = end > eventsPerThread - margin ? end - (eventsPerThread - margin) : 0;
+
+        for (size_t i = begin; i < end; i++) {
+            const ProfileEvent& event = buffer->events[i % eventsPerThread];
+
+            stream << ",{\"name\":";
+            writeJsonString(stream, event.name);
+            stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                   << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+        }
+    }
+
+    stream << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+    std::cout << "PROFILER: Trace written to " << filename << std::endl;
+    return true;
+}
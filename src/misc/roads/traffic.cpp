@@ -0,0 +1,465 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/roads/traffic.hpp"
+
+#include "components/roadComponent.hpp"
+#include "components/transformationComponent.hpp"
+#include "misc/configuration.hpp"
+#include "misc/coordinateTransform.hpp"
+#include "misc/direction.hpp"
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <unordered_map>
+
+std::pair<glm::vec3, glm::vec3> TrafficLane::sample(float distance) const {
+    distance = glm::clamp(distance, 0.0f, length);
+
+    // end point of the segment that contains the distance
+    const std::size_t segment = std::upper_bound(distances.begin() + 1, distances.end() - 1, distance) - distances.begin();
+    const glm::vec3& start = points[segment - 1];
+    const glm::vec3& end = points[segment];
+
+    const float segmentLength = distances[segment] - distances[segment - 1];
+    const float t = (distance - distances[segment - 1]) / segmentLength;
+
+    return {glm::mix(start, end, t), (end - start) / segmentLength};
+}
+
+TrafficNetwork::TrafficNetwork()
+    : random(Configuration::worldSeed) {
+}
+
+float TrafficNetwork::calculateAcceleration(float velocity, float gap, float leaderVelocity) {
+    const float brakingFactor = 1.0f / (2.0f * glm::sqrt(Configuration::carAcceleration * Configuration::carDeceleration));
+    const float desiredGap = Configuration::carMinimumGap + glm::max(0.0f, velocity * Configuration::carTimeHeadway + velocity * (velocity - leaderVelocity) * brakingFactor);
+
+    const float relativeVelocity = velocity / Configuration::carVelocity;
+    const float relativeGap = desiredGap / glm::max(gap, 0.01f);
+
+    return Configuration::carAcceleration * (1.0f - relativeVelocity * relativeVelocity * relativeVelocity * relativeVelocity - relativeGap * relativeGap);
+}
+
+bool TrafficNetwork::canEnter(unsigned int index) const {
+    const TrafficLane& lane = lanes[index];
+    if (!lane.positions.empty() && lane.positions.back() < Configuration::carLength + Configuration::carMinimumGap) {
+        return false;
+    }
+
+    if (lane.node == TrafficLane::none) {
+        return true;
+    }
+
+    const TrafficNode& node = nodes[lane.node];
+    if (node.grantedSide == TrafficNode::noSide) {
+        return true;
+    }
+
+    return node.grantedSide == lane.entrySide && node.grantTime < Configuration::intersectionGreenTime;
+}
+
+unsigned int TrafficNetwork::chooseNextLane(const TrafficLane& lane) {
+    if (lane.successors.empty()) {
+        return TrafficLane::none;
+    }
+
+    std::uniform_int_distribution<std::size_t> distribution(0, lane.successors.size() - 1);
+    return lane.successors[distribution(random)];
+}
+
+void TrafficNetwork::calculateAccelerations(TrafficLane& lane) const {
+    const std::size_t count = lane.getVehiclesCount();
+    if (count == 0) {
+        return;
+    }
+
+    // the first vehicle follows the last vehicle of its next lane or stops at the end of its lane
+    float gap = lane.length - lane.positions[0];
+    float leaderVelocity = 0.0f;
+
+    const unsigned int next = lane.nextLanes[0];
+    if (next != TrafficLane::none && canEnter(next)) {
+        const TrafficLane& nextLane = lanes[next];
+
+        if (nextLane.getVehiclesCount() > 0) {
+            gap += nextLane.positions.back() - Configuration::carLength;
+            leaderVelocity = nextLane.velocities.back();
+        }
+        else {
+            gap += nextLane.length;
+            leaderVelocity = Configuration::carVelocity;
+        }
+    }
+
+    lane.accelerations[0] = calculateAcceleration(lane.velocities[0], gap, leaderVelocity);
+
+    for (std::size_t i = 1; i < count; i++) {
+        lane.accelerations[i] = calculateAcceleration(lane.velocities[i], lane.positions[i - 1] - lane.positions[i] - Configuration::carLength, lane.velocities[i - 1]);
+    }
+}
+
+void TrafficNetwork::integrate(TrafficLane& lane, float dt) {
+    const std::size_t count = lane.getVehiclesCount();
+
+    for (std::size_t i = 0; i < count; i++) {
+        lane.velocities[i] = glm::max(0.0f, lane.velocities[i] + dt * lane.accelerations[i]);
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        lane.positions[i] += dt * lane.velocities[i];
+    }
+
+    // a vehicle must not pass the vehicle in front of it, even if the time step is too large for the model
+    for (std::size_t i = 1; i < count; i++) {
+        lane.positions[i] = glm::min(lane.positions[i], lane.positions[i - 1] - Configuration::carLength);
+    }
+}
+
+void TrafficNetwork::updateGrants(float dt) {
+    for (TrafficNode& node : nodes) {
+        if (node.grantedSide != TrafficNode::noSide) {
+            node.grantTime += dt;
+        }
+
+        // the node is only handed over when the vehicles of the granted side left it
+        const bool expired = node.grantTime >= Configuration::intersectionGreenTime || (node.waitingSides & (1u << node.grantedSide)) == 0;
+        if (node.occupants == 0 && expired) {
+            // the sides are granted in turn, starting after the side that was granted last
+            const unsigned int first = node.grantedSide == TrafficNode::noSide ? 0 : node.grantedSide + 1;
+            node.grantedSide = TrafficNode::noSide;
+
+            for (unsigned int i = 0; i < 4; i++) {
+                const unsigned int side = (first + i) % 4;
+
+                if (node.waitingSides & (1u << side)) {
+                    node.grantedSide = side;
+                    node.grantTime = 0.0f;
+                    break;
+                }
+            }
+        }
+
+        // the waiting sides are collected again while the vehicles are transferred
+        node.waitingSides = 0;
+    }
+}
+
+void TrafficNetwork::transferVehicles() {
+    PROFILE_FUNCTION();
+    for (TrafficLane& lane : lanes) {
+        std::size_t leaving = 0;
+
+        while (leaving < lane.getVehiclesCount() && lane.positions[leaving] >= lane.length) {
+            const unsigned int next = lane.nextLanes[leaving];
+
+            if (next == TrafficLane::none || !canEnter(next)) {
+                // the vehicle waits at the end of its lane
+                lane.positions[leaving] = lane.length;
+                lane.velocities[leaving] = 0.0f;
+                break;
+            }
+
+            enterLane(next, lane.positions[leaving] - lane.length, lane.velocities[leaving]);
+            leaving++;
+        }
+
+        if (leaving > 0) {
+            if (lane.node != TrafficLane::none) {
+                nodes[lane.node].occupants -= leaving;
+            }
+
+            lane.positions.erase(lane.positions.begin(), lane.positions.begin() + leaving);
+            lane.velocities.erase(lane.velocities.begin(), lane.velocities.begin() + leaving);
+            lane.accelerations.erase(lane.accelerations.begin(), lane.accelerations.begin() + leaving);
+            lane.nextLanes.erase(lane.nextLanes.begin(), lane.nextLanes.begin() + leaving);
+        }
+
+        // the first vehicle asks the next node for admission when it approaches it
+        if (lane.getVehiclesCount() > 0 && lane.nextLanes[0] != TrafficLane::none) {
+            const TrafficLane& next = lanes[lane.nextLanes[0]];
+
+            if (next.node != TrafficLane::none && lane.length - lane.positions[0] < Configuration::intersectionApproachDistance) {
+                nodes[next.node].waitingSides |= 1u << next.entrySide;
+            }
+        }
+    }
+}
+
+void TrafficNetwork::enterLane(unsigned int index, float position, float velocity) {
+    TrafficLane& lane = lanes[index];
+
+    if (lane.node != TrafficLane::none) {
+        TrafficNode& node = nodes[lane.node];
+        if (node.grantedSide == TrafficNode::noSide) {
+            node.grantedSide = lane.entrySide;
+            node.grantTime = 0.0f;
+        }
+
+        node.occupants++;
+    }
+
+    if (!lane.positions.empty()) {
+        position = glm::min(position, lane.positions.back() - Configuration::carLength);
+    }
+
+    lane.positions.push_back(position);
+    lane.velocities.push_back(velocity);
+    lane.accelerations.push_back(0.0f);
+    lane.nextLanes.push_back(chooseNextLane(lane));
+}
+
+void TrafficNetwork::build(entt::registry& registry) {
+    PROFILE_FUNCTION();
+    // the vehicles are carried over to the rebuilt lanes with the same key, separately for edges and nodes
+    std::unordered_map<glm::ivec4, TrafficLane> previousEdgeLanes;
+    std::unordered_map<glm::ivec4, TrafficLane> previousNodeLanes;
+    for (TrafficLane& lane : lanes) {
+        if (lane.getVehiclesCount() > 0) {
+            auto& previous = lane.node == TrafficLane::none ? previousEdgeLanes : previousNodeLanes;
+            previous.emplace(lane.key, std::move(lane));
+        }
+    }
+
+    lanes.clear();
+    nodes.clear();
+    vehiclesCount = 0;
+
+    std::unordered_map<glm::ivec2, unsigned int> nodeIndices;
+    std::vector<glm::ivec2> nodeCells;
+    // lanes of every node by the side at which they enter the node
+    std::vector<std::array<std::vector<unsigned int>, 4>> entries;
+    // edge lane that leaves every node at each side
+    std::vector<std::array<unsigned int, 4>> exits;
+    // node lanes and the sides at which they leave their node
+    std::vector<std::pair<unsigned int, unsigned int>> nodeLanes;
+    // edge lanes, the nodes they arrive at and their direction
+    std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> edgeLanes;
+
+    const auto getNode = [&](const glm::ivec2& cell) {
+        const auto& [it, inserted] = nodeIndices.try_emplace(cell, static_cast<unsigned int>(nodes.size()));
+        if (inserted) {
+            nodes.emplace_back();
+            nodeCells.push_back(cell);
+            entries.emplace_back();
+            exits.emplace_back().fill(TrafficLane::none);
+        }
+
+        return it->second;
+    };
+
+    const auto addLane = [&](const RoadPath& path, const glm::vec3& offset, const glm::ivec4& key) {
+        TrafficLane& lane = lanes.emplace_back();
+        lane.key = key;
+
+        for (const glm::vec3& point : path) {
+            const glm::vec3 position = point + offset;
+
+            if (!lane.points.empty()) {
+                const float distance = glm::distance(lane.points.back(), position);
+                if (distance <= 0.0f) {
+                    continue;
+                }
+
+                lane.length += distance;
+            }
+
+            lane.points.push_back(position);
+            lane.distances.push_back(lane.length);
+        }
+
+        if (lane.points.size() < 2) {
+            lanes.pop_back();
+            return TrafficLane::none;
+        }
+
+        return static_cast<unsigned int>(lanes.size() - 1);
+    };
+
+    registry.view<RoadComponent, TransformationComponent>().each([&](const RoadComponent& road, const TransformationComponent& transform) {
+        const glm::ivec2 origin = glm::ivec2(glm::round(utility::worldToNormalizedWorldGridCoords(transform.position)));
+
+        for (const auto& [position, paths] : road.graph.getNodes()) {
+            const unsigned int node = getNode(origin + position);
+
+            for (unsigned int i = 0; i < 4; i++) {
+                for (unsigned int j = 0; j < 4; j++) {
+                    const unsigned int lane = addLane(paths[i][j], transform.position, glm::ivec4(origin + position, i, j));
+                    if (lane == TrafficLane::none) {
+                        continue;
+                    }
+
+                    lanes[lane].node = node;
+                    lanes[lane].entrySide = i;
+
+                    entries[node][i].push_back(lane);
+                    nodeLanes.emplace_back(lane, j);
+                }
+            }
+        }
+
+        for (const auto& [edge, path] : road.graph.getEdges()) {
+            // adjacent nodes have no edge path and are connected like nodes of neighbouring chunks
+            const auto& [start, end] = edge;
+            const unsigned int lane = addLane(path, transform.position, glm::ivec4(origin + start, origin + end));
+            if (lane == TrafficLane::none) {
+                continue;
+            }
+
+            const unsigned int side = static_cast<unsigned int>(utility::getDirection(glm::vec2(end - start)));
+
+            exits[getNode(origin + start)][side] = lane;
+            edgeLanes.emplace_back(lane, getNode(origin + end), side);
+        }
+    });
+
+    std::vector<unsigned int> exitSides(lanes.size(), TrafficNode::noSide);
+    for (const auto& [lane, side] : nodeLanes) {
+        exitSides[lane] = side;
+    }
+
+    // lanes of the node that can be entered when driving in the given direction. Turning back is only allowed at dead ends
+    const auto getEntries = [&](unsigned int node, unsigned int direction) {
+        const unsigned int side = static_cast<unsigned int>(utility::getInverse(static_cast<Direction>(direction)));
+        const std::vector<unsigned int>& candidates = entries[node][side];
+
+        std::vector<unsigned int> result;
+        for (unsigned int lane : candidates) {
+            if (exitSides[lane] != side || candidates.size() == 1) {
+                result.push_back(lane);
+            }
+        }
+
+        return result;
+    };
+
+    for (const auto& [lane, side] : nodeLanes) {
+        const unsigned int node = lanes[lane].node;
+
+        if (exits[node][side] != TrafficLane::none) {
+            lanes[lane].successors.push_back(exits[node][side]);
+            continue;
+        }
+
+        auto it = nodeIndices.find(nodeCells[node] + DirectionVectors<glm::ivec2>.at(static_cast<Direction>(side)));
+        if (it != nodeIndices.end()) {
+            lanes[lane].successors = getEntries(it->second, side);
+        }
+    }
+
+    for (const auto& [lane, node, side] : edgeLanes) {
+        lanes[lane].successors = getEntries(node, side);
+    }
+
+    for (TrafficLane& lane : lanes) {
+        const auto& previousLanes = lane.node == TrafficLane::none ? previousEdgeLanes : previousNodeLanes;
+        auto it = previousLanes.find(lane.key);
+        if (it == previousLanes.end()) {
+            continue;
+        }
+
+        // the positions are clamped, since the path of the lane may have become shorter
+        const TrafficLane& previous = it->second;
+        for (std::size_t i = 0; i < previous.getVehiclesCount(); i++) {
+            lane.positions.push_back(glm::min(previous.positions[i], lane.length));
+            lane.velocities.push_back(previous.velocities[i]);
+            lane.accelerations.push_back(0.0f);
+            lane.nextLanes.push_back(chooseNextLane(lane));
+        }
+
+        vehiclesCount += lane.getVehiclesCount();
+        if (lane.node != TrafficLane::none) {
+            TrafficNode& node = nodes[lane.node];
+            node.occupants += static_cast<unsigned int>(lane.getVehiclesCount());
+            node.grantedSide = lane.entrySide;
+            node.grantTime = 0.0f;
+        }
+    }
+}
+
+void TrafficNetwork::spawnVehicles(std::size_t count) {
+    static constexpr float spacing = 2.0f * (Configuration::carLength + Configuration::carMinimumGap);
+
+    for (TrafficLane& lane : lanes) {
+        // the nodes are only entered through their admission and lanes with carried over vehicles stay as they are
+        if (lane.node != TrafficLane::none || lane.getVehiclesCount() > 0) {
+            continue;
+        }
+
+        for (float position = lane.length - 0.5f * spacing; position >= 0.0f && vehiclesCount < count; position -= spacing) {
+            lane.positions.push_back(position);
+            lane.velocities.push_back(0.0f);
+            lane.accelerations.push_back(0.0f);
+            lane.nextLanes.push_back(chooseNextLane(lane));
+
+            vehiclesCount++;
+        }
+    }
+}
+
+void TrafficNetwork::update(float dt) {
+    PROFILE_FUNCTION();
+    updateGrants(dt);
+
+    JobSystem& jobs = JobSystem::get();
+
+    // the accelerations read the vehicles of the next lanes, so all lanes are integrated afterwards
+    jobs.parallelFor(0, lanes.size(), lanesPerJob, [this](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            calculateAccelerations(lanes[i]);
+        }
+    });
+
+    jobs.parallelFor(0, lanes.size(), lanesPerJob, [this, dt](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            integrate(lanes[i], dt);
+        }
+    });
+
+    transferVehicles();
+}
+
+void TrafficNetwork::getTransforms(std::vector<glm::mat4>& transforms) const {
+    PROFILE_FUNCTION();
+    transforms.resize(vehiclesCount);
+
+    // the vehicles of every lane are written behind the vehicles of the previous lanes
+    std::vector<std::size_t> offsets(lanes.size());
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < lanes.size(); i++) {
+        offsets[i] = offset;
+        offset += lanes[i].getVehiclesCount();
+    }
+
+    JobSystem::get().parallelFor(0, lanes.size(), lanesPerJob, [this, &transforms, &offsets](std::size_t first, std::size_t last) {
+        static const glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
+
+        for (std::size_t i = first; i < last; i++) {
+            const TrafficLane& lane = lanes[i];
+
+            for (std::size_t j = 0; j < lane.getVehiclesCount(); j++) {
+                // the car model points along the x axis
+                const auto& [position, forward] = lane.sample(lane.positions[j]);
+                const glm::vec3 side = glm::normalize(glm::cross(forward, up));
+                const glm::vec3 normal = glm::cross(side, forward);
+
+                transforms[offsets[i] + j] = glm::mat4(glm::vec4(forward, 0.0f), glm::vec4(normal, 0.0f), glm::vec4(side, 0.0f), glm::vec4(position, 1.0f));
+            }
+        }
+    });
+}
@@ -0,0 +1,93 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/spatialGrid.hpp"
+
+#include "misc/coordinateTransform.hpp"
+
+#include <algorithm>
+#include <utility>
+
+SpatialGrid::Cell* SpatialGrid::findCell(const glm::ivec2& cell) {
+    const auto& [chunk, position] = utility::normalizedWorldGridToNormalizedChunkGridCoords(cell);
+
+    auto it = chunks.find(chunk);
+    if (it == chunks.end()) {
+        return nullptr;
+    }
+
+    return &it->second[position.y * Configuration::cellsPerChunk + position.x];
+}
+
+const SpatialGrid::Cell* SpatialGrid::findCell(const glm::ivec2& cell) const {
+    return const_cast<SpatialGrid*>(this)->findCell(cell);
+}
+
+void SpatialGrid::insert(const glm::ivec2& cell, const GridItem& item) {
+    const auto& [chunk, position] = utility::normalizedWorldGridToNormalizedChunkGridCoords(cell);
+
+    // the cells of a chunk are created with its first item
+    std::vector<Cell>& cells = chunks[chunk];
+    if (cells.empty()) {
+        cells.resize(Configuration::cellsPerChunk * Configuration::cellsPerChunk);
+    }
+
+    cells[position.y * Configuration::cellsPerChunk + position.x].push_back(item);
+}
+
+bool SpatialGrid::remove(const glm::ivec2& cell, const GridItem& item) {
+    Cell* items = findCell(cell);
+    if (items == nullptr) {
+        return false;
+    }
+
+    auto it = std::find(items->begin(), items->end(), item);
+    if (it == items->end()) {
+        return false;
+    }
+
+    // the order of the items in a cell does not matter
+    *it = std::move(items->back());
+    items->pop_back();
+    return true;
+}
+
+void SpatialGrid::replace(const glm::ivec2& cell, const GridItem& item, const GridItem& newItem) {
+    Cell* items = findCell(cell);
+    if (items == nullptr) {
+        return;
+    }
+
+    auto it = std::find(items->begin(), items->end(), item);
+    if (it != items->end()) {
+        *it = newItem;
+    }
+}
+
+const std::vector<GridItem>& SpatialGrid::query(const glm::ivec2& cell) const {
+    static const Cell empty;
+
+    const Cell* items = findCell(cell);
+    return items != nullptr ? *items : empty;
+}
+
+std::vector<GridItem> SpatialGrid::take(const glm::ivec2& cell) {
+    Cell* items = findCell(cell);
+    if (items == nullptr) {
+        return {};
+    }
+
+    return std::exchange(*items, {});
+}
@@ -0,0 +1,254 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "misc/systemScheduler.hpp"
+
+#include "misc/profiler.hpp"
+#include "systems/system.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+bool SystemAccess::writesComponent(entt::id_type id) const {
+    return std::any_of(writes.begin(), writes.end(), [id](const ComponentType& type) { return type.id == id; });
+}
+
+bool SystemAccess::accessesComponent(entt::id_type id) const {
+    return writesComponent(id) || std::any_of(reads.begin(), reads.end(), [id](const ComponentType& type) { return type.id == id; });
+}
+
+bool SystemAccess::conflicts(const SystemAccess& other) const {
+    if (structural || other.structural) {
+        return true;
+    }
+
+    for (const ComponentType& type : writes) {
+        if (other.accessesComponent(type.id)) {
+            return true;
+        }
+    }
+
+    for (const ComponentType& type : other.writes) {
+        if (accessesComponent(type.id)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief Returns the readable name of the dynamic type of the system
+static std::string getSystemName(const System& system) {
+    std::string name = typeid(system).name();
+
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (status == 0) {
+        name = demangled;
+    }
+    std::free(demangled);
+#else
+    if (name.starts_with("class ")) {
+        name = name.substr(6);
+    }
+#endif
+
+    return name;
+}
+
+SystemScheduler::SystemScheduler(entt::registry& registry)
+    : registry(registry) {
+}
+
+SystemScheduler::NodeId SystemScheduler::add(System* system, float dt) {
+    const NodeId id = add(getSystemName(*system), system->getAccess(), [system, dt]() { system->update(dt); });
+    nodes[id].type = std::type_index(typeid(*system));
+
+    return id;
+}
+
+SystemScheduler::NodeId SystemScheduler::add(const std::string& name, const SystemAccess& access, std::function<void()> function) {
+    nodes.emplace_back(name, access, std::type_index(typeid(void)), std::move(function));
+
+    return nodes.size() - 1;
+}
+
+void SystemScheduler::precede(NodeId first, NodeId second) {
+    orderings.emplace_back(first, second);
+}
+
+void SystemScheduler::buildGraph() {
+    PROFILE_FUNCTION();
+    componentTypes.clear();
+
+    // conflicting nodes run in the order in which they were added
+    for (NodeId j = 0; j < nodes.size(); j++) {
+        Node& node = nodes[j];
+
+        for (NodeId i = 0; i < j; i++) {
+            const Node& previous = nodes[i];
+
+            const bool sameSystem = node.type == previous.type && node.type != std::type_index(typeid(void));
+            const bool ordered = std::find(node.access.after.begin(), node.access.after.end(), previous.type) != node.access.after.end();
+
+            if (sameSystem || ordered || node.access.conflicts(previous.access)) {
+                nodes[i].successors.push_back(j);
+                node.dependencies++;
+            }
+        }
+
+        // the storages are created before the systems run, because creating them changes the registry
+        for (const auto* types : {&node.access.reads, &node.access.writes}) {
+            for (const ComponentType& type : *types) {
+                if (std::none_of(componentTypes.begin(), componentTypes.end(), [&type](const ComponentType& other) { return other.id == type.id; })) {
+                    type.assure(registry);
+                    componentTypes.push_back(type);
+                }
+            }
+        }
+    }
+
+    for (const auto& [first, second] : orderings) {
+        std::vector<NodeId>& successors = nodes[first].successors;
+
+        if (std::find(successors.begin(), successors.end(), second) == successors.end()) {
+            successors.push_back(second);
+            nodes[second].dependencies++;
+        }
+    }
+
+    for (Node& node : nodes) {
+        node.remaining.store(node.dependencies, std::memory_order_relaxed);
+    }
+}
+
+void SystemScheduler::makeReady(NodeId id) {
+    if (nodes[id].access.mainThread) {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        readyNodes.push_back(id);
+    }
+    else {
+        JobSystem::get().submit([this, id]() { execute(id); }, &workerJobs, JobPriority::HIGH);
+    }
+}
+
+void SystemScheduler::execute(NodeId id) {
+    Node& node = nodes[id];
+    node.function();
+
+    for (const NodeId successor : node.successors) {
+        if (nodes[successor].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            makeReady(successor);
+        }
+    }
+
+    // counted after the successors are scheduled, so that the main thread does not stop waiting before
+    finishedNodes.fetch_add(1, std::memory_order_release);
+}
+
+void SystemScheduler::run() {
+    PROFILE_FUNCTION();
+    buildGraph();
+
+    if (validation) {
+        runValidated();
+    }
+    else {
+        finishedNodes = 0;
+        for (NodeId id = 0; id < nodes.size(); id++) {
+            if (nodes[id].dependencies == 0) {
+                makeReady(id);
+            }
+        }
+
+        // the main thread runs its own nodes and helps with the jobs of the other nodes while it waits
+        while (finishedNodes.load(std::memory_order_acquire) < nodes.size()) {
+            NodeId id = 0;
+            bool ready = false;
+            {
+                std::lock_guard<std::mutex> lock(readyMutex);
+                if (!readyNodes.empty()) {
+                    id = readyNodes.front();
+                    readyNodes.pop_front();
+                    ready = true;
+                }
+            }
+
+            if (ready) {
+                execute(id);
+            }
+            else if (!JobSystem::get().runJob(JobPriority::HIGH)) {
+                std::this_thread::yield();
+            }
+        }
+
+        JobSystem::get().wait(workerJobs);
+    }
+
+    nodes.clear();
+    orderings.clear();
+}
+
+void SystemScheduler::runValidated() {
+    std::vector<std::uint64_t> hashes(componentTypes.size());
+
+    for (const ComponentType& type : componentTypes) {
+        if (type.hash == nullptr && uncheckedTypes.insert(type.id).second) {
+            std::cerr << "SystemScheduler: " << type.name << " does not declare hashState and is not validated" << std::endl;
+        }
+    }
+
+    // the nodes are added in a valid order, so they can run one after another
+    for (NodeId id = 0; id < nodes.size(); id++) {
+        const Node& node = nodes[id];
+
+        for (std::size_t i = 0; i < componentTypes.size(); i++) {
+            if (componentTypes[i].hash != nullptr) {
+                hashes[i] = componentTypes[i].hash(registry);
+            }
+        }
+
+        // the nodes still run on their threads, so that the result does not depend on the validation
+        if (node.access.mainThread) {
+            node.function();
+        }
+        else {
+            JobSystem::get().submit(node.function, &workerJobs, JobPriority::HIGH);
+            JobSystem::get().wait(workerJobs);
+        }
+
+        if (node.access.structural) {
+            continue;
+        }
+
+        for (std::size_t i = 0; i < componentTypes.size(); i++) {
+            const ComponentType& type = componentTypes[i];
+            if (type.hash == nullptr || node.access.writesComponent(type.id)) {
+                continue;
+            }
+
+            if (type.hash(registry) != hashes[i]) {
+                std::cerr << "SystemScheduler: " << node.name << " changed " << type.name << " without declaring write access" << std::endl;
+            }
+        }
+    }
+}
@@ -15,11 +15,13 @@
  */
 #include "rendering/geometry.hpp"
 
+#include "rendering/renderStats.hpp"
+
 Geometry::Geometry(const VertexAttributes& attributes, int drawMode)
     : drawMode(drawMode), drawCount(0) {
     glGenVertexArrays(1, &vao);
 
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
     glGenBuffers(1, &vbo);
     glGenBuffers(1, &ebo);
@@ -46,7 +48,7 @@ Geometry::Geometry(const VertexAttributes& attributes, int drawMode)
 }
 
 void Geometry::setVertexAttribute(unsigned int index, const VertexAttribute& attribute) const {
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
     glEnableVertexAttribArray(index);
 
     glBindBuffer(GL_ARRAY_BUFFER, attribute.vbo == 0 ? this->vbo : attribute.vbo);
@@ -64,13 +66,13 @@ void Geometry::setVertexAttribute(unsigned int index, const VertexAttribute& att
 }
 
 void Geometry::bufferData(const std::vector<float>& vertices, const std::vector<unsigned int>& indices, unsigned int usage) {
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), usage);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), usage);
+    counted::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), usage);
+    counted::bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), usage);
 
     drawCount = indices.size();
 
@@ -80,14 +82,14 @@ void Geometry::bufferData(const std::vector<float>& vertices, const std::vector<
 }
 
 void Geometry::draw() const {
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
-    glDrawElements(drawMode, drawCount, GL_UNSIGNED_INT, 0);
+    counted::drawElements(drawMode, drawCount, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
 }
 
 void Geometry::bindBuffer() const {
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
@@ -105,35 +107,43 @@ MeshGeometry::MeshGeometry()
     : Geometry(meshVertexAttributes) {
 }
 
-MeshGeometry::MeshGeometry(const GeometryData& data, unsigned int usage)
+MeshGeometry::MeshGeometry(const GeometryData& data, unsigned int usage, bool retainData)
     : Geometry(meshVertexAttributes) {
+    if (retainData) {
+        this->data = std::make_shared<const GeometryData>(data);
+    }
+
     bufferData(data, usage);
 }
 
 void MeshGeometry::bufferData(const GeometryData& data, unsigned int usage) {
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 
-    glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(Vertex), data.vertices.data(), usage);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(unsigned int), data.indices.data(), usage);
+    counted::bufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(Vertex), data.vertices.data(), usage);
+    counted::bufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(unsigned int), data.indices.data(), usage);
 
     drawCount = data.indices.size();
     culling = data.culling;
 
+    if (this->data && this->data.get() != &data) {
+        this->data = std::make_shared<const GeometryData>(data);
+    }
+
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void MeshGeometry::bufferSubData(const std::vector<Vertex>& vertices, unsigned int offset) {
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 
-    glBufferSubData(GL_ARRAY_BUFFER, offset, vertices.size() * sizeof(Vertex), vertices.data());
+    counted::bufferSubData(GL_ARRAY_BUFFER, offset, vertices.size() * sizeof(Vertex), vertices.data());
 
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -159,9 +169,9 @@ void MeshGeometry::drawInstanced(unsigned int instancesCount) const {
         glDisable(GL_CULL_FACE);
     }
 
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
-    glDrawElementsInstanced(drawMode, drawCount, GL_UNSIGNED_INT, 0, instancesCount);
+    counted::drawElementsInstanced(drawMode, drawCount, GL_UNSIGNED_INT, 0, instancesCount);
 
     glBindVertexArray(0);
 }
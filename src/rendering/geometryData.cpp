@@ -43,6 +43,9 @@ GeometryData GeometryData::merge(const GeometryData& first, const GeometryData&
 void GeometryData::addData(const GeometryData& data) {
     int indexOffset = vertices.size();
 
+    vertices.reserve(vertices.size() + data.vertices.size());
+    indices.reserve(indices.size() + data.indices.size());
+
     for (const Vertex& vertex : data.vertices) {
         this->vertices.push_back(vertex);
     }
@@ -55,6 +58,8 @@ void GeometryData::addData(const GeometryData& data) {
 GeometryData GeometryData::transformVertices(const std::function<Vertex(const Vertex&)>& transform) const {
     GeometryData transformedData;
     transformedData.indices = indices;
+    transformedData.culling = culling;
+    transformedData.vertices.reserve(vertices.size());
 
     for (const Vertex& vert : vertices) {
         transformedData.vertices.emplace_back(transform(vert));
@@ -66,6 +71,8 @@ GeometryData GeometryData::transformVertices(const std::function<Vertex(const Ve
 GeometryData GeometryData::transformVertices(const glm::mat4& transform) const {
     GeometryData transformedData;
     transformedData.indices = indices;
+    transformedData.culling = culling;
+    transformedData.vertices.reserve(vertices.size());
 
     const glm::mat3& normalMatrix = glm::mat3(glm::transpose(glm::inverse(transform)));
     for (const Vertex& vert : vertices) {
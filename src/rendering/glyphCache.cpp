@@ -0,0 +1,268 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "rendering/glyphCache.hpp"
+
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+GlyphCache::GlyphCache() {
+    if (FT_Init_FreeType(&library)) {
+        std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+    }
+
+    // the memory of all pages is allocated once
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_R8, pageSize, pageSize, maxPages);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    for (int page = 0; page < maxPages; page++) {
+        clearPage(page);
+    }
+}
+
+GlyphCache::~GlyphCache() {
+    if (rasterizationTask.valid()) {
+        rasterizationTask.wait();
+    }
+
+    for (FT_Face face : faces) {
+        FT_Done_Face(face);
+    }
+
+    if (library != nullptr) {
+        FT_Done_FreeType(library);
+    }
+
+    glDeleteTextures(1, &texture);
+}
+
+unsigned int GlyphCache::loadFont(const std::string& filename) {
+    FT_Face face;
+    if (FT_New_Face(library, filename.c_str(), 0, &face)) {
+        std::cout << "ERROR::FREETYPE: Failed to load font " << filename << std::endl;
+        return 0;
+    }
+
+    faces.push_back(face);
+    return faces.size() - 1;
+}
+
+const GlyphCache::Glyph* GlyphCache::getGlyph(const GlyphKey& key) {
+    const auto& it = glyphs.find(key);
+    if (it != glyphs.end()) {
+        if (it->second.page >= 0) {
+            pages[it->second.page].lastUsed = frame;
+        }
+
+        return &it->second;
+    }
+
+    // request the glyph once
+    if (key.font < faces.size() && pendingGlyphs.insert(key).second) {
+        requests.push_back(key);
+    }
+
+    return nullptr;
+}
+
+void GlyphCache::usePages(unsigned int pageMask) {
+    for (int page = 0; page < pages.size(); page++) {
+        if (pageMask & (1u << page)) {
+            pages[page].lastUsed = frame;
+        }
+    }
+}
+
+void GlyphCache::update() {
+    frame++;
+
+    if (rasterizationTask.valid() && rasterizationTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+
+        for (const GlyphBitmap& bitmap : rasterizationTask.get()) {
+            addGlyph(bitmap);
+            pendingGlyphs.erase(bitmap.key);
+        }
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        generation++;
+    }
+
+    if (!rasterizationTask.valid() && !requests.empty()) {
+        rasterizationTask = JobSystem::get().async([keys = std::move(requests), this]() {
+            return rasterizeGlyphs(keys, faces);
+        });
+
+        requests.clear();
+    }
+}
+
+std::vector<GlyphCache::GlyphBitmap> GlyphCache::rasterizeGlyphs(const std::vector<GlyphKey>& keys, const std::vector<FT_Face>& faces) {
+    PROFILE_FUNCTION();
+    std::vector<GlyphBitmap> bitmaps;
+    bitmaps.reserve(keys.size());
+
+    for (const GlyphKey& key : keys) {
+        GlyphBitmap& result = bitmaps.emplace_back(key, glm::ivec2(0), glm::ivec2(0), 0);
+
+        FT_Face face = faces[key.font];
+        FT_Set_Pixel_Sizes(face, 0, key.pixelSize);
+
+        // glyphs that fail to load are stored empty, so that they are not requested again
+        if (FT_Load_Char(face, key.codepoint, FT_LOAD_RENDER)) {
+            continue;
+        }
+
+        const FT_Bitmap& bitmap = face->glyph->bitmap;
+        result.size = glm::ivec2(bitmap.width, bitmap.rows);
+        result.bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+        result.advance = face->glyph->advance.x >> 6;
+
+        result.pixels.resize(bitmap.width * bitmap.rows);
+        for (unsigned int row = 0; row < bitmap.rows; row++) {
+            std::copy_n(bitmap.buffer + row * bitmap.pitch, bitmap.width, result.pixels.data() + row * bitmap.width);
+        }
+    }
+
+    return bitmaps;
+}
+
+void GlyphCache::addGlyph(const GlyphBitmap& bitmap) {
+    Glyph glyph{bitmap.size, bitmap.bearing, bitmap.advance, -1, glm::vec2(0.0f), glm::vec2(0.0f)};
+
+    if (bitmap.size.x > 0 && bitmap.size.y > 0) {
+        glm::ivec2 position;
+        glyph.page = allocate(bitmap.size, position);
+        if (glyph.page < 0) {
+            std::cout << "ERROR::GLYPH_CACHE: Glyph does not fit into an atlas page" << std::endl;
+            return;
+        }
+
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, position.x, position.y, glyph.page, bitmap.size.x, bitmap.size.y, 1, GL_RED, GL_UNSIGNED_BYTE, bitmap.pixels.data());
+
+        glyph.uvMin = glm::vec2(position) / static_cast<float>(pageSize);
+        glyph.uvMax = glm::vec2(position + bitmap.size) / static_cast<float>(pageSize);
+    }
+
+    glyphs[bitmap.key] = glyph;
+}
+
+int GlyphCache::allocate(const glm::ivec2& size, glm::ivec2& position) {
+    if (size.x + 2 * padding > pageSize || size.y + 2 * padding > pageSize) {
+        return -1;
+    }
+
+    // pack the glyphs into rows
+    const auto& tryAllocate = [&](Page& page) {
+        glm::ivec2 cursor = page.cursor;
+        int rowHeight = page.rowHeight;
+
+        if (cursor.x + size.x + padding > pageSize) {
+            cursor = glm::ivec2(padding, cursor.y + rowHeight + padding);
+            rowHeight = 0;
+        }
+
+        if (cursor.y + size.y + padding > pageSize) {
+            return false;
+        }
+
+        position = cursor;
+        page.cursor = glm::ivec2(cursor.x + size.x + padding, cursor.y);
+        page.rowHeight = glm::max(rowHeight, size.y);
+        page.lastUsed = frame;
+
+        return true;
+    };
+
+    for (int i = 0; i < pages.size(); i++) {
+        if (tryAllocate(pages[i])) {
+            return i;
+        }
+    }
+
+    if (pages.size() < maxPages) {
+        pages.emplace_back();
+        tryAllocate(pages.back());
+
+        return pages.size() - 1;
+    }
+
+    // all pages are full, so the least recently used page is reused
+    const auto& leastRecentlyUsed = std::min_element(pages.begin(), pages.end(), [](const Page& a, const Page& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+    const int page = std::distance(pages.begin(), leastRecentlyUsed);
+
+    clearPage(page);
+    tryAllocate(pages[page]);
+
+    return page;
+}
+
+void GlyphCache::clearPage(int page) {
+    std::erase_if(glyphs, [page](const auto& entry) {
+        return entry.second.page == page;
+    });
+
+    if (page < pages.size()) {
+        pages[page] = Page();
+    }
+
+    const std::vector<unsigned char> empty(pageSize * pageSize, 0);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, page, pageSize, pageSize, 1, GL_RED, GL_UNSIGNED_BYTE, empty.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+unsigned int GlyphCache::getPixelSize(int textSize) {
+    for (unsigned int pixelSize : pixelSizes) {
+        if (pixelSize >= textSize) {
+            return pixelSize;
+        }
+    }
+
+    return pixelSizes.back();
+}
+
+bool GlyphCache::hasPendingGlyphs() const {
+    return !pendingGlyphs.empty();
+}
+
+unsigned int GlyphCache::getTexture() const {
+    return texture;
+}
+
+unsigned int GlyphCache::getGeneration() const {
+    return generation;
+}
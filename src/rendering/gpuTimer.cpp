@@ -0,0 +1,111 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "rendering/gpuTimer.hpp"
+
+#include "misc/profiler.hpp"
+
+#include <iostream>
+
+#include <GL/glew.h>
+
+GpuTimer::GpuTimer() {
+    supported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+    if (!supported) {
+        std::cerr << "GPU_TIMER: Timer queries are not supported" << std::endl;
+        return;
+    }
+
+    glGenQueries(latency * passesCount * 2, &queries[0][0][0]);
+
+    // the gpu timestamps are moved to the profiler clock, so that the passes line up with the cpu zones
+    GLint64 gpuTime;
+    glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+    clockOffset = Profiler::get().now() - gpuTime;
+}
+
+GpuTimer::~GpuTimer() {
+    if (supported) {
+        glDeleteQueries(latency * passesCount * 2, &queries[0][0][0]);
+    }
+}
+
+void GpuTimer::beginFrame() {
+    if (!supported) {
+        return;
+    }
+
+    frame = (frame + 1) % latency;
+    resolve(frame);
+}
+
+void GpuTimer::resolve(int slot) {
+    for (int pass = 0; pass < passesCount; pass++) {
+        times[pass] = 0.0f;
+        valid[pass] = false;
+
+        if (!issued[slot][pass]) {
+            continue;
+        }
+
+        issued[slot][pass] = false;
+
+        // results that are still not available are dropped instead of waiting for them
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(queries[slot][pass][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+
+        GLuint64 start, end;
+        glGetQueryObjectui64v(queries[slot][pass][0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(queries[slot][pass][1], GL_QUERY_RESULT, &end);
+
+        times[pass] = (end - start) / 1000000.0f;
+        valid[pass] = true;
+
+#ifdef PROFILING
+        Profiler::get().recordGpu(getPassName(static_cast<RenderPass>(pass)), static_cast<int64_t>(start) + clockOffset, static_cast<int64_t>(end) + clockOffset);
+#endif
+    }
+}
+
+void GpuTimer::begin(RenderPass pass) {
+    if (supported) {
+        glQueryCounter(queries[frame][static_cast<int>(pass)][0], GL_TIMESTAMP);
+    }
+}
+
+void GpuTimer::end(RenderPass pass) {
+    if (supported) {
+        glQueryCounter(queries[frame][static_cast<int>(pass)][1], GL_TIMESTAMP);
+        issued[frame][static_cast<int>(pass)] = true;
+    }
+}
+
+const char* GpuTimer::getPassName(RenderPass pass) {
+    switch (pass) {
+        case RenderPass::SHADOW:
+            return "GPU shadow pass";
+        case RenderPass::SCENE:
+            return "GPU scene pass";
+        case RenderPass::DEBUG:
+            return "GPU debug pass";
+        case RenderPass::GUI:
+            return "GPU gui pass";
+        default:
+            return "GPU";
+    }
+}
@@ -0,0 +1,146 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "rendering/guiRenderer.hpp"
+
+#include "rendering/renderStats.hpp"
+#include "rendering/shader.hpp"
+#include "rendering/texture.hpp"
+
+#include <cstddef>
+
+#include <GL/glew.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+GuiRenderer::GuiRenderer()
+    : shader(new ShaderProgram("res/shaders/gui.vert", "res/shaders/gui.frag")) {
+    glGenVertexArrays(1, &vao);
+    counted::bindVertexArray(vao);
+
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(GuiVertex), (void*)offsetof(GuiVertex, position));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GuiVertex), (void*)offsetof(GuiVertex, texCoord));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(GuiVertex), (void*)offsetof(GuiVertex, color));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(GuiVertex), (void*)offsetof(GuiVertex, area));
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(GuiVertex), (void*)offsetof(GuiVertex, cornerRadius));
+    glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(GuiVertex), (void*)offsetof(GuiVertex, type));
+    glVertexAttribPointer(6, 1, GL_FLOAT, GL_FALSE, sizeof(GuiVertex), (void*)offsetof(GuiVertex, layer));
+
+    for (int i = 0; i < 7; i++) {
+        glEnableVertexAttribArray(i);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+GuiRenderer::~GuiRenderer() {
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+
+    delete shader;
+}
+
+void GuiRenderer::begin(float width, float height) {
+    vertices.clear();
+    currentTexture = nullptr;
+    drawCalls = 0;
+
+    shader->use();
+    shader->setMatrix4("projection", glm::ortho(0.0f, width, height, 0.0f));
+    shader->setInt("glyphAtlas", 0);
+    shader->setInt("tex", 1);
+
+    glActiveTexture(GL_TEXTURE0);
+    counted::bindTexture(GL_TEXTURE_2D_ARRAY, glyphAtlas);
+}
+
+void GuiRenderer::flush() {
+    if (vertices.empty()) {
+        return;
+    }
+
+    const unsigned int size = vertices.size() * sizeof(GuiVertex);
+    if (size > capacity) {
+        capacity = glm::max(size, 2 * capacity);
+    }
+
+    // the storage is orphaned, so the driver does not have to wait for the previous draw
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    counted::bufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    counted::bufferSubData(GL_ARRAY_BUFFER, 0, size, vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    counted::bindVertexArray(vao);
+    counted::drawArrays(GL_TRIANGLES, 0, vertices.size());
+    glBindVertexArray(0);
+
+    vertices.clear();
+    drawCalls++;
+}
+
+void GuiRenderer::end() {
+    flush();
+
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void GuiRenderer::setGlyphAtlas(unsigned int texture) {
+    glyphAtlas = texture;
+}
+
+void GuiRenderer::addQuad(const Rectangle& area, const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& color, const Rectangle& widgetArea, float cornerRadius, QuadType type, float layer) {
+    const glm::vec4 widget = glm::vec4(widgetArea.x, widgetArea.y, widgetArea.width, widgetArea.height);
+    const float typeValue = static_cast<float>(type);
+
+    const GuiVertex topLeft = {glm::vec2(area.x, area.y), uvMin, color, widget, cornerRadius, typeValue, layer};
+    const GuiVertex topRight = {glm::vec2(area.x + area.width, area.y), glm::vec2(uvMax.x, uvMin.y), color, widget, cornerRadius, typeValue, layer};
+    const GuiVertex bottomLeft = {glm::vec2(area.x, area.y + area.height), glm::vec2(uvMin.x, uvMax.y), color, widget, cornerRadius, typeValue, layer};
+    const GuiVertex bottomRight = {glm::vec2(area.x + area.width, area.y + area.height), uvMax, color, widget, cornerRadius, typeValue, layer};
+
+    vertices.insert(vertices.end(), {bottomLeft, topRight, topLeft, bottomLeft, bottomRight, topRight});
+}
+
+void GuiRenderer::drawRect(const Rectangle& area, const glm::vec4& color, float cornerRadius) {
+    // invisible backgrounds are skipped
+    if (color.a <= 0.0f) {
+        return;
+    }
+
+    addQuad(area, glm::vec2(0.0f), glm::vec2(1.0f), color, area, cornerRadius, QuadType::COLOR);
+}
+
+void GuiRenderer::drawTexture(const Rectangle& area, const Texture* texture) {
+    if (texture != currentTexture) {
+        flush();
+
+        currentTexture = texture;
+        texture->use(1);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    // textures are stored bottom up
+    addQuad(area, glm::vec2(0.0f, 1.0f), glm::vec2(1.0f, 0.0f), glm::vec4(1.0f), area, 0.0f, QuadType::TEXTURE);
+}
+
+void GuiRenderer::drawGlyph(const Rectangle& area, const glm::vec2& uvMin, const glm::vec2& uvMax, int layer, const glm::vec4& color) {
+    addQuad(area, uvMin, uvMax, color, area, 0.0f, QuadType::TEXT, static_cast<float>(layer));
+}
+
+unsigned int GuiRenderer::getDrawCalls() const {
+    return drawCalls;
+}
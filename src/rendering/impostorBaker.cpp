@@ -0,0 +1,113 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "rendering/impostorBaker.hpp"
+
+#include "rendering/texture.hpp"
+
+#include <GL/glew.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+MeshPtr ImpostorBaker::bake(const Mesh<>& mesh, ShaderPtr impostorShader, ShaderProgram* bakeShader, unsigned int resolution, unsigned int frames) {
+    Mesh<>* impostor = new Mesh<>(impostorShader);
+
+    int viewport[4];
+    int previousFramebuffer;
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    TexturePtr blackTexture = TexturePtr(new Texture(glm::vec3(0.0f), 1, 1));
+
+    for (const auto& [name, object] : mesh.geometries) {
+        if (!mesh.boundingSpheres.contains(name)) {
+            continue;
+        }
+
+        const glm::vec4& boundingSphere = mesh.boundingSpheres.at(name);
+        const glm::vec3 center = glm::vec3(boundingSphere);
+        const float radius = boundingSphere.w;
+
+        // render target
+        TexturePtr atlas = TexturePtr(new Texture(frames * resolution, resolution));
+
+        unsigned int fbo, depthBuffer;
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, atlas->getID(), 0);
+
+        glGenRenderbuffers(1, &depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, frames * resolution, resolution);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+        glEnable(GL_DEPTH_TEST);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // render one frame per direction
+        bakeShader->use();
+        bakeShader->setMatrix4("projection", glm::ortho(-radius, radius, -radius, radius, 0.0f, 4.0f * radius));
+
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            const float angle = 2.0f * glm::pi<float>() * frame / frames;
+            const glm::vec3 eye = center + 2.0f * radius * glm::vec3(glm::cos(angle), 0.0f, glm::sin(angle));
+
+            bakeShader->setMatrix4("view", glm::lookAt(eye, center, glm::vec3(0.0f, 1.0f, 0.0f)));
+            glViewport(frame * resolution, 0, resolution, resolution);
+
+            for (const auto& [material, geometry] : object) {
+                if (material) {
+                    material->use(bakeShader);
+                }
+
+                geometry->draw();
+            }
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+        glDeleteRenderbuffers(1, &depthBuffer);
+        glDeleteFramebuffers(1, &fbo);
+
+        atlas->generateMipmaps();
+
+        // camera facing quad. The position holds the center of the bounding sphere, the tangent the corner offset and the number of frames
+        GeometryData data;
+        data.culling = false;
+        data.indices = {0, 1, 2, 0, 2, 3};
+
+        constexpr glm::vec2 corners[4] = {
+            glm::vec2(-1.0f, -1.0f),
+            glm::vec2(1.0f, -1.0f),
+            glm::vec2(1.0f, 1.0f),
+            glm::vec2(-1.0f, 1.0f),
+        };
+
+        for (const glm::vec2& corner : corners) {
+            data.vertices.emplace_back(center, 0.5f * (corner + 1.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(radius * corner, static_cast<float>(frames)));
+        }
+
+        Material* material = new Material(atlas, blackTexture);
+        material->ambientTexture = atlas;
+
+        impostor->geometries[name].emplace_back(MaterialPtr(material), GeometryPtr(new MeshGeometry(data)));
+    }
+
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    impostor->boundingSpheres = mesh.boundingSpheres;
+    impostor->boundingSphere = mesh.boundingSphere;
+
+    return MeshPtr(impostor);
+}
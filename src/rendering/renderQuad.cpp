@@ -15,12 +15,14 @@
  */
 #include "rendering/renderQuad.hpp"
 
+#include "rendering/renderStats.hpp"
+
 #include <GL/glew.h>
 
 RenderQuad::RenderQuad() {
     glGenVertexArrays(1, &vao);
 
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
     glGenBuffers(1, &vbo);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
@@ -39,7 +41,7 @@ RenderQuad::~RenderQuad() {
 }
 
 void RenderQuad::draw(float xMin, float yMin, float width, float height) const {
-    glBindVertexArray(vao);
+    counted::bindVertexArray(vao);
 
     float vertices[] = {
         xMin, yMin + height, 0.0f, 0.0f,            // bottom left
@@ -51,9 +53,9 @@ void RenderQuad::draw(float xMin, float yMin, float width, float height) const {
         xMin + width, yMin, 1.0f, 1.0f};            // top right
 
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
+    counted::bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    counted::drawArrays(GL_TRIANGLES, 0, 6);
 }
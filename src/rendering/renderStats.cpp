@@ -0,0 +1,134 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "rendering/renderStats.hpp"
+
+#include <iostream>
+
+RenderCounters& RenderCounters::operator+=(const RenderCounters& other) {
+    drawCalls += other.drawCalls;
+    instances += other.instances;
+    triangles += other.triangles;
+    programSwitches += other.programSwitches;
+    textureBinds += other.textureBinds;
+    uniformSets += other.uniformSets;
+    vaoBinds += other.vaoBinds;
+    uploadBytes += other.uploadBytes;
+
+    return *this;
+}
+
+RenderStats& RenderStats::get() {
+    static RenderStats stats;
+    return stats;
+}
+
+bool RenderStats::openCsv(const std::string& filename) {
+    csvStream.open(filename);
+    if (!csvStream.is_open()) {
+        std::cerr << "RENDER_STATS: Failed to open " << filename << std::endl;
+        return false;
+    }
+
+    csvStream << "frame,pass,category,drawCalls,instances,triangles,programSwitches,textureBinds,uniformSets,vaoBinds,uploadBytes\n";
+    return true;
+}
+
+void RenderStats::beginFrame() {
+    for (int p = 0; p < renderPassesCount; p++) {
+        for (int c = 0; c < categoriesCount; c++) {
+            const RenderCounters& counter = counters[p][c];
+
+            if (csvStream.is_open() && !counter.empty()) {
+                csvStream << frame << ',' << getPassName(static_cast<RenderPass>(p)) << ',' << getCategoryName(static_cast<RenderCategory>(c)) << ','
+                          << counter.drawCalls << ',' << counter.instances << ',' << counter.triangles << ',' << counter.programSwitches << ','
+                          << counter.textureBinds << ',' << counter.uniformSets << ',' << counter.vaoBinds << ',' << counter.uploadBytes << '\n';
+            }
+
+            lastFrame[p][c] = counter;
+            counters[p][c] = RenderCounters{};
+        }
+    }
+
+    frame++;
+    pass = RenderPass::OTHER;
+    category = RenderCategory::OTHER;
+}
+
+void RenderStats::countDraw(GLenum mode, unsigned int count, unsigned int instances) {
+    RenderCounters& counter = current();
+    counter.drawCalls++;
+    counter.instances += instances;
+
+    switch (mode) {
+        case GL_TRIANGLES:
+            counter.triangles += static_cast<uint64_t>(count / 3) * instances;
+            break;
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN:
+            counter.triangles += static_cast<uint64_t>(count > 2 ? count - 2 : 0) * instances;
+            break;
+        default:
+            break;
+    }
+}
+
+RenderCounters RenderStats::getPassCounters(RenderPass pass) const {
+    RenderCounters result;
+    for (int c = 0; c < categoriesCount; c++) {
+        result += lastFrame[static_cast<int>(pass)][c];
+    }
+
+    return result;
+}
+
+RenderCounters RenderStats::getCategoryCounters(RenderCategory category) const {
+    RenderCounters result;
+    for (int p = 0; p < renderPassesCount; p++) {
+        result += lastFrame[p][static_cast<int>(category)];
+    }
+
+    return result;
+}
+
+const char* RenderStats::getPassName(RenderPass pass) {
+    switch (pass) {
+        case RenderPass::SHADOW:
+            return "shadow";
+        case RenderPass::SCENE:
+            return "scene";
+        case RenderPass::DEBUG:
+            return "debug";
+        case RenderPass::GUI:
+            return "gui";
+        default:
+            return "other";
+    }
+}
+
+const char* RenderStats::getCategoryName(RenderCategory category) {
+    switch (category) {
+        case RenderCategory::MESH:
+            return "MeshComponent";
+        case RenderCategory::INSTANCED_MESH:
+            return "InstancedMeshComponent";
+        case RenderCategory::MULTI_INSTANCED_MESH:
+            return "MultiInstancedMeshComponent";
+        case RenderCategory::ROAD_MESH:
+            return "RoadMeshComponent";
+        default:
+            return "other";
+    }
+}
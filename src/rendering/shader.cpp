@@ -16,6 +16,7 @@
 #include "rendering/shader.hpp"
 
 #include "misc/configuration.hpp"
+#include "rendering/renderStats.hpp"
 
 #include <fstream>
 #include <iostream>
@@ -138,7 +139,7 @@ ShaderProgram::ShaderProgram(const std::string& vertexPath, const std::string& f
 }
 
 void ShaderProgram::use() const {
-    glUseProgram(program);
+    counted::useProgram(program);
 }
 
 unsigned int ShaderProgram::getLocation(const std::string& name) {
@@ -156,40 +157,40 @@ unsigned int ShaderProgram::getLocation(const std::string& name) {
 
 void ShaderProgram::setBool(const std::string& name, bool value) {
     unsigned int location = getLocation(name);
-    glUniform1i(location, (int)value);
+    counted::uniform1i(location, (int)value);
 }
 
 void ShaderProgram::setInt(const std::string& name, int value) {
     unsigned int location = getLocation(name);
-    glUniform1i(location, value);
+    counted::uniform1i(location, value);
 }
 
 void ShaderProgram::setFloat(const std::string& name, float value) {
     unsigned int location = getLocation(name);
-    glUniform1f(location, value);
+    counted::uniform1f(location, value);
 }
 
 void ShaderProgram::setVector2(const std::string& name, const glm::vec2& vec) {
     unsigned int location = getLocation(name);
-    glUniform2f(location, vec.x, vec.y);
+    counted::uniform2f(location, vec.x, vec.y);
 }
 
 void ShaderProgram::setVector3(const std::string& name, const glm::vec3& vec) {
     unsigned int location = getLocation(name);
-    glUniform3f(location, vec.x, vec.y, vec.z);
+    counted::uniform3f(location, vec.x, vec.y, vec.z);
 }
 
 void ShaderProgram::setVector4(const std::string& name, const glm::vec4& vec) {
     unsigned int location = getLocation(name);
-    glUniform4f(location, vec.x, vec.y, vec.z, vec.w);
+    counted::uniform4f(location, vec.x, vec.y, vec.z, vec.w);
 }
 
 void ShaderProgram::setMatrix3(const std::string& name, const glm::mat3& mat) {
     unsigned int location = getLocation(name);
-    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+    counted::uniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat));
 }
 
 void ShaderProgram::setMatrix4(const std::string& name, const glm::mat4& mat) {
     unsigned int location = getLocation(name);
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+    counted::uniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
 }
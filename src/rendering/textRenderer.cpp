@@ -16,72 +16,95 @@
 #include "rendering/textRenderer.hpp"
 
 #include <GL/glew.h>
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
-#include <glm/gtc/matrix_transform.hpp>
+/// @brief Decodes the UTF-8 encoded text. Invalid bytes are skipped
+static std::vector<char32_t> decodeUtf8(const std::string& text) {
+    std::vector<char32_t> codepoints;
+    codepoints.reserve(text.size());
+
+    for (size_t i = 0; i < text.size();) {
+        const unsigned char lead = text[i];
+
+        int length;
+        char32_t codepoint;
+        if (lead < 0x80) {
+            length = 1;
+            codepoint = lead;
+        }
+        else if ((lead & 0xE0) == 0xC0) {
+            length = 2;
+            codepoint = lead & 0x1F;
+        }
+        else if ((lead & 0xF0) == 0xE0) {
+            length = 3;
+            codepoint = lead & 0x0F;
+        }
+        else if ((lead & 0xF8) == 0xF0) {
+            length = 4;
+            codepoint = lead & 0x07;
+        }
+        else {
+            i++;
+            continue;
+        }
+
+        if (i + length > text.size()) {
+            break;
+        }
+
+        bool valid = true;
+        for (int j = 1; j < length; j++) {
+            const unsigned char continuation = text[i + j];
+            valid &= (continuation & 0xC0) == 0x80;
+            codepoint = (codepoint << 6) | (continuation & 0x3F);
+        }
+
+        if (valid) {
+            codepoints.push_back(codepoint);
+            i += length;
+        }
+        else {
+            i++;
+        }
+    }
+
+    return codepoints;
+}
+
+TextRenderer::~TextRenderer() {
+    if (face != nullptr) {
+        FT_Done_Face(face);
+    }
+
+    if (library != nullptr) {
+        FT_Done_FreeType(library);
+    }
+}
 
 void TextRenderer::init() {
-    FT_Library ft;
-    if (FT_Init_FreeType(&ft)) {
+    if (FT_Init_FreeType(&library)) {
         std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
     }
 
     static constexpr const char* filename = "res/fonts/Montserrat-Regular.ttf";
 
-    FT_Face face;
-    if (FT_New_Face(ft, filename, 0, &face)) {
+    if (FT_New_Face(library, filename, 0, &face)) {
         std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
     }
 
+    // the kerning table is filled when the character pairs are used
     useKerning = FT_HAS_KERNING(face);
+    if (useKerning) {
+        kerning.resize(charactersCount * charactersCount, 0);
+    }
 
     FT_Set_Pixel_Sizes(face, 0, pixelWidth);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    for (unsigned char c = 0; c < 128; c++) {
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-            std::cout << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
-            continue;
-        }
-
-        Character character;
-        glGenTextures(1, &character.textureId);
-        glBindTexture(GL_TEXTURE_2D, character.textureId);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        character.size = glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows);
-        character.bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
-        character.advance = face->glyph->advance.x;
-
-        characters[c] = character;
-
-        if (useKerning) {
-            FT_Vector vec;
-            for (unsigned char d = 0; d < 128; d++) {
-                FT_Get_Kerning(face, c, d, FT_KERNING_DEFAULT, &vec);
-
-                kerning.emplace(std::make_pair(c, d), glm::ivec2{vec.x, vec.y});
-            }
-        }
-    }
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-    glBindTexture(GL_TEXTURE_2D, 0);
 
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    // the glyphs are rasterized when they are used first
+    font = glyphCache.loadFont(filename);
 }
 
 void TextRenderer::setScreenSize(float width, float height) {
@@ -89,79 +112,158 @@ void TextRenderer::setScreenSize(float width, float height) {
     screenHeight = height;
 }
 
-float TextRenderer::getWidth(const std::string& text, int textSize) const {
-    float width = 0;
-    for (auto it = text.begin(); it != text.end(); it++) {
-        const Character& character = characters.at(*it);
-        width += (character.advance >> 6);
+void TextRenderer::update() {
+    const unsigned int generation = glyphCache.getGeneration();
+    glyphCache.update();
+
+    // the cached layouts may contain missing or removed glyphs
+    if (glyphCache.getGeneration() != generation) {
+        layouts.clear();
+    }
+}
+
+int TextRenderer::getKerning(char32_t first, char32_t second) const {
+    if (!useKerning) {
+        return 0;
+    }
+
+    // pairs outside of the table are rare and not cached
+    if (first >= charactersCount || second >= charactersCount) {
+        FT_Vector vec;
+        FT_Get_Kerning(face, FT_Get_Char_Index(face, first), FT_Get_Char_Index(face, second), FT_KERNING_DEFAULT, &vec);
+
+        return vec.x;
+    }
+
+    if (!kerningLoaded[first]) {
+        // FT_Get_Kerning expects glyph indices instead of character codes
+        const FT_UInt firstIndex = FT_Get_Char_Index(face, first);
+
+        FT_Vector vec;
+        for (int c = 0; c < charactersCount; c++) {
+            FT_Get_Kerning(face, firstIndex, FT_Get_Char_Index(face, c), FT_KERNING_DEFAULT, &vec);
+            kerning[first * charactersCount + c] = vec.x;
+        }
+
+        kerningLoaded[first] = true;
     }
 
-    return width * textSize / pixelWidth;
+    return kerning[first * charactersCount + second];
 }
 
-float TextRenderer::getHeight(const std::string& text, int textSize, float* baselineOffset) const {
-    *baselineOffset = 0;
+TextLayoutPtr TextRenderer::getLayout(const std::string& text, int textSize) const {
+    LayoutKey key{text, textSize};
 
-    float height = 0.0f;
-    for (auto it = text.begin(); it != text.end(); it++) {
-        const Character& character = characters.at(*it);
-        if (height < character.size.y) {
-            height = character.size.y;
+    const auto& it = layouts.find(key);
+    if (it != layouts.end()) {
+        return it->second;
+    }
+
+    // remove the layouts that are not referenced anymore
+    if (layouts.size() >= maxCachedLayouts) {
+        std::erase_if(layouts, [](const auto& entry) {
+            return entry.second.use_count() == 1;
+        });
+    }
+
+    TextLayoutPtr layout = createLayout(text, textSize);
+    layouts.emplace(std::move(key), layout);
+
+    return layout;
+}
+
+TextLayoutPtr TextRenderer::createLayout(const std::string& text, int textSize) const {
+    const std::vector<char32_t> codepoints = decodeUtf8(text);
+
+    TextLayout* layout = new TextLayout();
+    layout->textSize = textSize;
+    layout->glyphs.reserve(codepoints.size());
+
+    // the glyphs are rasterized with the next larger pixel size and scaled down
+    const unsigned int pixelSize = GlyphCache::getPixelSize(textSize);
+    const float scale = static_cast<float>(textSize) / pixelSize;
+    const float kerningScale = static_cast<float>(textSize) / pixelWidth;
+
+    float width = 0.0f;
+    float ascent = 0.0f;
+    float descent = 0.0f;
+
+    for (auto it = codepoints.begin(); it != codepoints.end(); it++) {
+        // missing glyphs are skipped. The layout is created again when they were added to the cache
+        const GlyphCache::Glyph* glyph = glyphCache.getGlyph(GlyphKey{font, *it, pixelSize});
+        if (glyph == nullptr) {
+            continue;
         }
 
-        float glyphBaselineOffset = (character.size.y - character.bearing.y);
-        if (glyphBaselineOffset > *baselineOffset) {
-            *baselineOffset = glyphBaselineOffset;
+        float offset = 0.0f;
+        if (it + 1 != codepoints.end()) {
+            offset = (getKerning(*it, *(it + 1)) >> 6) * kerningScale;
         }
+
+        // the glyph is positioned relative to the pen position on the baseline
+        if (glyph->page >= 0) {
+            const glm::vec2 position = glm::vec2(width + glyph->bearing.x * scale + offset, -glyph->bearing.y * scale);
+            layout->glyphs.emplace_back(position, glm::vec2(glyph->size) * scale, glyph->uvMin, glyph->uvMax, glyph->page);
+
+            layout->pages |= 1u << glyph->page;
+        }
+
+        width += glyph->advance * scale;
+        ascent = std::max(ascent, glyph->bearing.y * scale);
+        descent = std::max(descent, (glyph->size.y - glyph->bearing.y) * scale);
     }
 
-    *baselineOffset *= textSize / pixelWidth;
-    return height * textSize / pixelWidth;
+    layout->width = width;
+    layout->height = ascent + descent;
+    layout->baselineOffset = descent;
+    layout->generation = glyphCache.getGeneration();
+
+    return TextLayoutPtr(layout);
 }
 
-void TextRenderer::renderText(const std::string& text, const Rectangle& rect, int textSize, TextAlign align) const {
-    // get width and height of non scaled text
-    float baselineOffset;
+float TextRenderer::getWidth(const std::string& text, int textSize) const {
+    return getLayout(text, textSize)->width;
+}
+
+float TextRenderer::getHeight(const std::string& text, int textSize, float* baselineOffset) const {
+    const TextLayoutPtr& layout = getLayout(text, textSize);
 
-    float width = getWidth(text, textSize);
-    float height = getHeight(text, textSize, &baselineOffset);
+    *baselineOffset = layout->baselineOffset;
+    return layout->height;
+}
 
+void TextRenderer::renderText(GuiRenderer& renderer, const TextLayout& layout, const Rectangle& rect, TextAlign align, const glm::vec4& color) const {
     float currentX;
     switch (align) {
         case TextAlign::BEGIN:
             currentX = rect.x;
             break;
         case TextAlign::CENTER:
-            currentX = rect.x + (rect.width - width) * 0.5f;
+            currentX = rect.x + (rect.width - layout.width) * 0.5f;
             break;
         case TextAlign::END:
-            currentX = rect.x + (rect.width - width);
+            currentX = rect.x + (rect.width - layout.width);
             break;
         default:
             break;
     }
-    float currentY = rect.y + rect.height - (baselineOffset + (rect.height - height) * 0.5f);
-
-    glActiveTexture(GL_TEXTURE0);
+    float currentY = rect.y + rect.height - (layout.baselineOffset + (rect.height - layout.height) * 0.5f);
 
-    for (auto it = text.begin(); it != text.end(); it++) {
-        glm::ivec2 offset(0.0f);
+    glyphCache.usePages(layout.pages);
 
-        Character character = characters.at(*it);
-        if (it + 1 != text.end() && useKerning) {
-            Character nextChar = characters.at(*(it + 1));
-            offset = kerning.at(std::make_pair(*it, *(it + 1)));
-        }
-
-        float xPos = currentX + (character.bearing.x + (offset.x >> 6)) * textSize / pixelWidth;
-        float yPos = currentY - character.bearing.y * textSize / pixelWidth;
+    for (const TextLayout::Glyph& glyph : layout.glyphs) {
+        renderer.drawGlyph(Rectangle{currentX + glyph.offset.x, currentY + glyph.offset.y, glyph.size.x, glyph.size.y}, glyph.uvMin, glyph.uvMax, glyph.page, color);
+    }
+}
 
-        float charHeight = character.size.y * textSize / pixelWidth;
-        float charWidth = character.size.x * textSize / pixelWidth;
+bool TextRenderer::hasPendingGlyphs() const {
+    return glyphCache.hasPendingGlyphs();
+}
 
-        glBindTexture(GL_TEXTURE_2D, character.textureId);
+unsigned int TextRenderer::getAtlasTexture() const {
+    return glyphCache.getTexture();
+}
 
-        quad.draw(xPos, yPos, charWidth, charHeight);
-        currentX += (character.advance >> 6) * textSize / pixelWidth;
-    }
+unsigned int TextRenderer::getGeneration() const {
+    return glyphCache.getGeneration();
 }
@@ -15,6 +15,8 @@
  */
 #include "rendering/texture.hpp"
 
+#include "rendering/renderStats.hpp"
+
 #include <GL/glew.h>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -99,7 +101,29 @@ Texture::Texture(const glm::vec4& rgba, int width, int height) {
     delete[] data;
 }
 
+Texture::Texture(int width, int height) {
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
 void Texture::use(unsigned int texUnit) const {
     glActiveTexture(GL_TEXTURE0 + texUnit);
+    counted::bindTexture(GL_TEXTURE_2D, texture);
+}
+
+void Texture::generateMipmaps() const {
     glBindTexture(GL_TEXTURE_2D, texture);
+    glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+unsigned int Texture::getID() const {
+    return texture;
 }
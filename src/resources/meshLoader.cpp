@@ -379,8 +379,8 @@ std::unordered_map<std::string, MaterialPtr> MeshLoader::loadMaterials(const std
     }
 }
 
-MeshPtr MeshLoader::loadMesh(const std::string& filename) {
-    Mesh<>* mesh = new Mesh<>();
+MeshData MeshLoader::parseMesh(const std::string& filename) {
+    MeshData mesh;
 
     std::ifstream file;
     file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
@@ -393,8 +393,6 @@ MeshPtr MeshLoader::loadMesh(const std::string& filename) {
 
         // process lines
         std::string prefix;
-
-        std::unordered_map<std::string, MaterialPtr> materials;
         std::string objectName;
 
         VertexIndices indexOffsets = VertexIndices(0, 0, 0);
@@ -403,16 +401,12 @@ MeshPtr MeshLoader::loadMesh(const std::string& filename) {
             std::stringstream sLine(line);
             sLine >> prefix;
 
-            // read material lib
+            // material libs contain textures, so they are loaded when the mesh is created
             if (prefix == "mtllib") {
                 std::string mtlFile;
 
                 sLine >> mtlFile;
-
-                const auto& mtllib = loadMaterials("res/models/" + mtlFile);
-                for (const auto& [name, material] : mtllib) {
-                    materials.emplace(name, material);
-                }
+                mesh.materialLibs.push_back(mtlFile);
             }
             // parse object data
             else if (prefix == "o") {
@@ -425,21 +419,13 @@ MeshPtr MeshLoader::loadMesh(const std::string& filename) {
 
                 // process faces
                 for (const auto& [materialName, faceIndices] : faceData) {
-                    MaterialPtr material = materials.at(materialName);
-
-                    // culled faces
                     GeometryData dataCulling = processFaces(faceIndices.indicesCulling, vertData);
                     dataCulling.culling = true;
 
-                    GeometryPtr cullingGeometry = GeometryPtr(new MeshGeometry(dataCulling));
-                    mesh->geometries[objectName].push_back(std::make_pair(material, cullingGeometry));
-
-                    // non culled faces
                     GeometryData dataNonCulling = processFaces(faceIndices.indicesNonCulling, vertData);
                     dataNonCulling.culling = false;
 
-                    GeometryPtr nonCullingGeometry = GeometryPtr(new MeshGeometry(dataNonCulling));
-                    mesh->geometries[objectName].push_back(std::make_pair(material, nonCullingGeometry));
+                    mesh.parts.emplace_back(objectName, materialName, std::move(dataCulling), std::move(dataNonCulling));
                 }
 
                 indexOffsets += VertexIndices(vertData.positions.size(), vertData.texCoords.size(), vertData.normals.size());
@@ -454,5 +440,37 @@ MeshPtr MeshLoader::loadMesh(const std::string& filename) {
         throw e;
     }
 
+    return mesh;
+}
+
+MeshPtr MeshLoader::createMesh(const MeshData& data) {
+    Mesh<>* mesh = new Mesh<>();
+
+    std::unordered_map<std::string, MaterialPtr> materials;
+    for (const std::string& mtlFile : data.materialLibs) {
+        const auto& mtllib = loadMaterials("res/models/" + mtlFile);
+        for (const auto& [name, material] : mtllib) {
+            materials.emplace(name, material);
+        }
+    }
+
+    for (const MeshPart& part : data.parts) {
+        MaterialPtr material = materials.at(part.materialName);
+
+        // culled faces
+        GeometryPtr cullingGeometry = GeometryPtr(new MeshGeometry(part.dataCulling, GL_STATIC_DRAW, true));
+        mesh->geometries[part.objectName].push_back(std::make_pair(material, cullingGeometry));
+
+        // non culled faces
+        GeometryPtr nonCullingGeometry = GeometryPtr(new MeshGeometry(part.dataNonCulling, GL_STATIC_DRAW, true));
+        mesh->geometries[part.objectName].push_back(std::make_pair(material, nonCullingGeometry));
+    }
+
+    mesh->calculateBoundingSpheres();
+
     return MeshPtr(mesh);
 }
+
+MeshPtr MeshLoader::loadMesh(const std::string& filename) {
+    return createMesh(parseMesh(filename));
+}
@@ -0,0 +1,289 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "resources/meshSimplifier.hpp"
+
+#include <map>
+#include <queue>
+#include <unordered_map>
+
+#include <glm/gtx/hash.hpp>
+
+MeshSimplifier::Quadric MeshSimplifier::Quadric::fromPlane(const glm::dvec4& p, double weight) {
+    Quadric q;
+    q.values[0] = weight * p.x * p.x;
+    q.values[1] = weight * p.x * p.y;
+    q.values[2] = weight * p.x * p.z;
+    q.values[3] = weight * p.x * p.w;
+    q.values[4] = weight * p.y * p.y;
+    q.values[5] = weight * p.y * p.z;
+    q.values[6] = weight * p.y * p.w;
+    q.values[7] = weight * p.z * p.z;
+    q.values[8] = weight * p.z * p.w;
+    q.values[9] = weight * p.w * p.w;
+
+    return q;
+}
+
+MeshSimplifier::Quadric& MeshSimplifier::Quadric::operator+=(const Quadric& other) {
+    for (int i = 0; i < 10; i++) {
+        values[i] += other.values[i];
+    }
+
+    return *this;
+}
+
+double MeshSimplifier::Quadric::evaluate(const glm::vec3& position) const {
+    const double x = position.x, y = position.y, z = position.z;
+
+    return values[0] * x * x + 2 * values[1] * x * y + 2 * values[2] * x * z + 2 * values[3] * x
+           + values[4] * y * y + 2 * values[5] * y * z + 2 * values[6] * y
+           + values[7] * z * z + 2 * values[8] * z
+           + values[9];
+}
+
+GeometryData MeshSimplifier::simplify(const GeometryData& data, float ratio) {
+    const unsigned int vertexCount = data.vertices.size();
+    const unsigned int triangleCount = data.indices.size() / 3;
+    const unsigned int targetCount = glm::max(1u, static_cast<unsigned int>(triangleCount * ratio));
+
+    if (triangleCount <= targetCount) {
+        return data;
+    }
+
+    // weld the vertices by position. The topology is simplified on the welded positions while the other attributes are taken from the original vertices
+    std::unordered_map<glm::vec3, unsigned int> positionIds;
+    std::vector<glm::vec3> positions;
+    std::vector<unsigned int> vertexPositions(vertexCount);
+
+    for (unsigned int v = 0; v < vertexCount; v++) {
+        const auto& [it, inserted] = positionIds.try_emplace(data.vertices[v].position, positions.size());
+        if (inserted) {
+            positions.push_back(data.vertices[v].position);
+        }
+
+        vertexPositions[v] = it->second;
+    }
+
+    const unsigned int positionCount = positions.size();
+
+    std::vector<std::array<unsigned int, 3>> triangles(triangleCount);
+    std::vector<std::array<unsigned int, 3>> corners(triangleCount);
+    std::vector<bool> triangleRemoved(triangleCount, false);
+    std::vector<std::vector<unsigned int>> positionTriangles(positionCount);
+
+    std::vector<Quadric> quadrics(positionCount);
+    std::vector<bool> locked(positionCount, false);
+    std::vector<bool> positionRemoved(positionCount, false);
+    std::vector<unsigned int> versions(positionCount, 0);
+
+    unsigned int remainingTriangles = triangleCount;
+
+    // build the initial quadrics from the triangle planes weighted by the triangle area
+    for (unsigned int t = 0; t < triangleCount; t++) {
+        corners[t] = {data.indices[3 * t], data.indices[3 * t + 1], data.indices[3 * t + 2]};
+        triangles[t] = {vertexPositions[corners[t][0]], vertexPositions[corners[t][1]], vertexPositions[corners[t][2]]};
+
+        const auto& triangle = triangles[t];
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) {
+            triangleRemoved[t] = true;
+            remainingTriangles--;
+            continue;
+        }
+
+        const glm::vec3& p0 = positions[triangle[0]];
+        const glm::vec3& p1 = positions[triangle[1]];
+        const glm::vec3& p2 = positions[triangle[2]];
+
+        const glm::dvec3 normal = glm::cross(glm::dvec3(p1 - p0), glm::dvec3(p2 - p0));
+        const double area = glm::length(normal);
+
+        for (unsigned int p : triangle) {
+            positionTriangles[p].push_back(t);
+        }
+
+        if (area > 0.0) {
+            const glm::dvec3 n = normal / area;
+            const Quadric q = Quadric::fromPlane(glm::dvec4(n, -glm::dot(n, glm::dvec3(p0))), area);
+
+            for (unsigned int p : triangle) {
+                quadrics[p] += q;
+            }
+        }
+    }
+
+    // edges with only one adjacent triangle are borders and must not move
+    std::map<std::pair<unsigned int, unsigned int>, unsigned int> edgeCounts;
+    for (unsigned int t = 0; t < triangleCount; t++) {
+        if (triangleRemoved[t]) {
+            continue;
+        }
+
+        for (int i = 0; i < 3; i++) {
+            const unsigned int a = triangles[t][i], b = triangles[t][(i + 1) % 3];
+            edgeCounts[std::make_pair(glm::min(a, b), glm::max(a, b))]++;
+        }
+    }
+
+    for (const auto& [edge, count] : edgeCounts) {
+        if (count == 1) {
+            locked[edge.first] = true;
+            locked[edge.second] = true;
+        }
+    }
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+    const auto pushCollapse = [&](unsigned int from, unsigned int to) {
+        if (locked[from]) {
+            return;
+        }
+
+        Quadric q = quadrics[from];
+        q += quadrics[to];
+
+        collapses.push(Collapse{q.evaluate(positions[to]), from, to, versions[from], versions[to]});
+    };
+
+    for (const auto& [edge, _] : edgeCounts) {
+        pushCollapse(edge.first, edge.second);
+        pushCollapse(edge.second, edge.first);
+    }
+
+    while (remainingTriangles > targetCount && !collapses.empty()) {
+        const Collapse collapse = collapses.top();
+        collapses.pop();
+
+        const unsigned int from = collapse.from, to = collapse.to;
+        if (positionRemoved[from] || positionRemoved[to] || versions[from] != collapse.fromVersion || versions[to] != collapse.toVersion) {
+            continue;
+        }
+
+        // reject collapses that would flip or degenerate triangles
+        bool valid = true;
+        for (unsigned int t : positionTriangles[from]) {
+            const auto& triangle = triangles[t];
+            if (triangleRemoved[t] || triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                continue;
+            }
+
+            glm::vec3 oldPositions[3], newPositions[3];
+            for (int i = 0; i < 3; i++) {
+                oldPositions[i] = positions[triangle[i]];
+                newPositions[i] = triangle[i] == from ? positions[to] : oldPositions[i];
+            }
+
+            const glm::vec3 oldNormal = glm::cross(oldPositions[1] - oldPositions[0], oldPositions[2] - oldPositions[0]);
+            const glm::vec3 newNormal = glm::cross(newPositions[1] - newPositions[0], newPositions[2] - newPositions[0]);
+
+            if (glm::dot(oldNormal, newNormal) <= 0.2f * glm::length(oldNormal) * glm::length(newNormal)) {
+                valid = false;
+                break;
+            }
+        }
+
+        if (!valid) {
+            continue;
+        }
+
+        for (unsigned int t : positionTriangles[from]) {
+            if (triangleRemoved[t]) {
+                continue;
+            }
+
+            auto& triangle = triangles[t];
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                triangleRemoved[t] = true;
+                remainingTriangles--;
+            }
+            else {
+                for (unsigned int& p : triangle) {
+                    if (p == from) {
+                        p = to;
+                    }
+                }
+
+                positionTriangles[to].push_back(t);
+            }
+        }
+
+        quadrics[to] += quadrics[from];
+        positionRemoved[from] = true;
+        versions[to]++;
+
+        // the costs of all edges at the target position changed
+        for (unsigned int t : positionTriangles[to]) {
+            if (triangleRemoved[t]) {
+                continue;
+            }
+
+            for (unsigned int p : triangles[t]) {
+                if (p != to) {
+                    pushCollapse(to, p);
+                    pushCollapse(p, to);
+                }
+            }
+        }
+    }
+
+    // copy the remaining triangles. Every corner keeps the attributes of its original vertex at the collapsed position
+    GeometryData result;
+    result.culling = data.culling;
+
+    std::map<std::pair<unsigned int, unsigned int>, unsigned int> indexMap;
+    for (unsigned int t = 0; t < triangleCount; t++) {
+        if (triangleRemoved[t]) {
+            continue;
+        }
+
+        for (int i = 0; i < 3; i++) {
+            const auto& key = std::make_pair(corners[t][i], triangles[t][i]);
+            const auto& [it, inserted] = indexMap.try_emplace(key, result.vertices.size());
+
+            if (inserted) {
+                Vertex vertex = data.vertices[corners[t][i]];
+                vertex.position = positions[triangles[t][i]];
+
+                result.vertices.push_back(vertex);
+            }
+
+            result.indices.push_back(it->second);
+        }
+    }
+
+    return result;
+}
+
+MeshPtr MeshSimplifier::simplify(const Mesh<>& mesh, float ratio) {
+    Mesh<>* result = new Mesh<>(mesh.shader);
+
+    for (const auto& [name, object] : mesh.geometries) {
+        for (const auto& [material, geometry] : object) {
+            const auto& meshGeometry = std::dynamic_pointer_cast<MeshGeometry>(geometry);
+
+            if (meshGeometry && meshGeometry->getData()) {
+                const GeometryData& simplified = simplify(*meshGeometry->getData(), ratio);
+                result->geometries[name].emplace_back(material, GeometryPtr(new MeshGeometry(simplified, GL_STATIC_DRAW)));
+            }
+            else {
+                result->geometries[name].emplace_back(material, geometry);
+            }
+        }
+    }
+
+    result->boundingSpheres = mesh.boundingSpheres;
+    result->boundingSphere = mesh.boundingSphere;
+
+    return MeshPtr(result);
+}
@@ -20,6 +20,7 @@
 #include "resources/resourceManager.hpp"
 
 #include <iostream>
+#include <utility>
 
 using namespace pugi;
 
@@ -44,10 +45,30 @@ MeshComponent ObjectLoader::loadComponent<MeshComponent>(const xml_node& node) {
 
     MeshPtr mesh = MeshLoader::loadMesh(resourceManager.resourceDir + filename);
     mesh->shader = resourceManager.getResource<Shader>(shaderID);
+    resourceManager.loadMeshLods(*mesh, node);
 
     return MeshComponent(mesh);
 }
 
+template<>
+OccluderComponent ObjectLoader::loadComponent<OccluderComponent>(const xml_node& node) {
+    std::vector<glm::vec3> triangles;
+
+    glm::vec3 min, max;
+    for (const xml_node& boxNode : node.children("box")) {
+        std::stringstream minStream(boxNode.attribute("min").as_string());
+        minStream >> min.x >> min.y >> min.z;
+
+        std::stringstream maxStream(boxNode.attribute("max").as_string());
+        maxStream >> max.x >> max.y >> max.z;
+
+        const OccluderComponent& box = OccluderComponent::fromBox(min, max);
+        triangles.insert(triangles.end(), box.triangles.begin(), box.triangles.end());
+    }
+
+    return OccluderComponent(triangles);
+}
+
 template<>
 ParkingComponent ObjectLoader::loadComponent<ParkingComponent>(const xml_node& node) {
     std::vector<ParkingSpot> spots;
@@ -69,7 +90,7 @@ ParkingComponent ObjectLoader::loadComponent<ParkingComponent>(const xml_node& n
 
 template<>
 CarPathComponent ObjectLoader::loadComponent<CarPathComponent>(const xml_node& node) {
-    std::unordered_map<std::string, CarPath> paths;
+    CarPaths paths;
 
     float x, y, z;
     for (const xml_node& pathNode : node.children("path")) {
@@ -95,7 +116,7 @@ CarPathComponent ObjectLoader::loadComponent<CarPathComponent>(const xml_node& n
         }
     }
 
-    return CarPathComponent(paths);
+    return CarPathComponent(std::move(paths));
 }
 
 template<>
@@ -115,6 +136,9 @@ ObjectPtr ObjectLoader::loadObject(const std::string& filename) {
     }
 
     Object* object = new Object();
+    MeshPtr mesh;
+    bool moving = false;
+
     for (const auto& node : doc.child("object")) {
         const std::string& name = node.name();
 
@@ -122,7 +146,13 @@ ObjectPtr ObjectLoader::loadObject(const std::string& filename) {
             object->name = node.text().as_string();
         }
         else if (name == "mesh") {
-            object->addComponent<MeshComponent>(loadComponent<MeshComponent>(node));
+            const MeshComponent& meshComponent = loadComponent<MeshComponent>(node);
+            mesh = meshComponent.mesh;
+
+            object->addComponent<MeshComponent>(meshComponent);
+        }
+        else if (name == "occluder") {
+            object->addComponent<OccluderComponent>(loadComponent<OccluderComponent>(node));
         }
         else if (name == "parking") {
             object->addComponent<ParkingComponent>(loadComponent<ParkingComponent>(node));
@@ -135,8 +165,14 @@ ObjectPtr ObjectLoader::loadObject(const std::string& filename) {
         }
         else if (name == "velocity") {
             object->addComponent<VelocityComponent>(loadComponent<VelocityComponent>(node));
+            moving = true;
         }
     }
 
+    // moving objects are never batched, so their mesh does not need the vertex data after loading
+    if (mesh && moving) {
+        mesh->releaseData();
+    }
+
     return ObjectPtr(object);
 }
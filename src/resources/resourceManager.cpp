@@ -15,15 +15,20 @@
  */
 #include "resources/resourceManager.hpp"
 
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
 #include "misc/roads/roadSpecs.hpp"
 #include "rendering/geometry.hpp"
+#include "rendering/impostorBaker.hpp"
 #include "rendering/material.hpp"
 #include "resources/mesh.hpp"
 #include "resources/meshLoader.hpp"
+#include "resources/meshSimplifier.hpp"
 #include "resources/objectLoader.hpp"
 #include "resources/roadGeometryGenerator.hpp"
 #include "resources/roadPack.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <stdexcept>
@@ -93,7 +98,44 @@ void ResourceManager::loadResource<Texture>(const std::string& id, const std::st
     setResource(id, TexturePtr(texture));
 }
 
+void ResourceManager::loadMeshLods(Mesh<std::string>& mesh, const xml_node& node) {
+    mesh.lods.clear();
+
+    for (const auto& lodNode : node.children()) {
+        const std::string& name = lodNode.name();
+        const float maxScreenSize = lodNode.attribute("maxScreenSize").as_float();
+
+        if (name == "lod") {
+            const std::string& filename = lodNode.attribute("filename").as_string();
+
+            MeshPtr lodMesh;
+            if (filename.empty()) {
+                lodMesh = MeshSimplifier::simplify(mesh, lodNode.attribute("simplify").as_float(0.5f));
+            }
+            else {
+                lodMesh = loadMesh(resourceDir + filename);
+                // detail levels are not batched and their bounding spheres are already calculated
+                lodMesh->releaseData();
+            }
+            lodMesh->shader = mesh.shader;
+
+            mesh.lods.emplace_back(lodMesh, maxScreenSize, false);
+        }
+        else if (name == "impostor") {
+            const std::string& shaderID = lodNode.attribute("shader").as_string("IMPOSTOR_SHADER");
+            const unsigned int resolution = lodNode.attribute("resolution").as_uint(128);
+            const unsigned int frames = lodNode.attribute("frames").as_uint(8);
+
+            ShaderPtr bakeShader = getResource<Shader>("IMPOSTOR_BAKE_SHADER");
+            MeshPtr impostor = ImpostorBaker::bake(mesh, getResource<Shader>(shaderID), bakeShader->defaultShader, resolution, frames);
+
+            mesh.lods.emplace_back(impostor, maxScreenSize, true);
+        }
+    }
+}
+
 void ResourceManager::loadResources() {
+    PROFILE_FUNCTION();
     xml_document doc;
     xml_parse_result result = doc.load_file((resourceDir + "resources.xml").c_str());
 
@@ -103,6 +145,9 @@ void ResourceManager::loadResources() {
         return;
     }
 
+    // the OpenGL objects have to be created on the main thread, so only the files are parsed in parallel
+    parseMeshes(doc);
+
     for (const auto& resourceNode : doc.child("resources").children("resource")) {
         const std::string& type = resourceNode.attribute("type").as_string();
 
@@ -184,8 +229,11 @@ void ResourceManager::loadResources() {
         else if (type == "mesh") {
             const std::string& shaderID = resourceNode.attribute("shader").as_string("MESH_SHADER");
 
-            MeshPtr mesh = MeshLoader::loadMesh(resourceDir + filename);
+            MeshPtr mesh = loadMesh(resourceDir + filename);
             mesh->shader = getResource<Shader>(shaderID);
+            loadMeshLods(*mesh, resourceNode);
+            // only building and road geometries are batched, so the data of resource meshes is not needed anymore
+            mesh->releaseData();
 
             setResource(id, mesh);
         }
@@ -217,4 +265,55 @@ void ResourceManager::loadResources() {
             setResource(id, object);
         }
     }
+
+    parsedMeshes.clear();
+}
+
+void ResourceManager::parseMeshes(const xml_document& doc) {
+    PROFILE_FUNCTION();
+    std::vector<std::string> paths;
+    for (const auto& resourceNode : doc.child("resources").children("resource")) {
+        if (std::string(resourceNode.attribute("type").as_string()) != "mesh") {
+            continue;
+        }
+
+        paths.push_back(resourceDir + resourceNode.attribute("filename").as_string());
+
+        for (const auto& lodNode : resourceNode.children("lod")) {
+            const std::string& filename = lodNode.attribute("filename").as_string();
+            if (!filename.empty()) {
+                paths.push_back(resourceDir + filename);
+            }
+        }
+    }
+
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+    std::vector<std::optional<MeshData>> meshes(paths.size());
+    JobSystem::get().parallelFor(0, paths.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            // files that can not be parsed are loaded again on the main thread, so that the error is reported there
+            try {
+                meshes[i] = MeshLoader::parseMesh(paths[i]);
+            }
+            catch (const std::exception&) {
+            }
+        }
+    });
+
+    for (int i = 0; i < paths.size(); i++) {
+        if (meshes[i]) {
+            parsedMeshes.emplace(paths[i], std::move(*meshes[i]));
+        }
+    }
+}
+
+MeshPtr ResourceManager::loadMesh(const std::string& path) {
+    auto it = parsedMeshes.find(path);
+    if (it != parsedMeshes.end()) {
+        return MeshLoader::createMesh(it->second);
+    }
+
+    return MeshLoader::loadMesh(path);
 }
@@ -24,13 +24,13 @@
 RoadPackGeometry RoadGeometryGenerator::generateRoadPackGeometries(const RoadSpecs& specs) {
     RoadPackGeometry geometries;
 
-    geometries[RoadTileTypes::NOT_CONNECTED] = GeometryPtr(new MeshGeometry(generateNotConnected(specs)));
-    geometries[RoadTileTypes::STRAIGHT] = GeometryPtr(new MeshGeometry(generateStraight(specs)));
-    geometries[RoadTileTypes::CURVE] = GeometryPtr(new MeshGeometry(generateCurve(specs)));
-    geometries[RoadTileTypes::T_CROSSING] = GeometryPtr(new MeshGeometry(generateTCrossing(specs)));
-    geometries[RoadTileTypes::CROSSING] = GeometryPtr(new MeshGeometry(generateCrossing(specs)));
-    geometries[RoadTileTypes::END] = GeometryPtr(new MeshGeometry(generateEnd(specs)));
-    geometries[RoadTileTypes::RAMP] = GeometryPtr(new MeshGeometry(generateRamp(specs)));
+    geometries[RoadTileTypes::NOT_CONNECTED] = GeometryPtr(new MeshGeometry(generateNotConnected(specs), GL_STATIC_DRAW, true));
+    geometries[RoadTileTypes::STRAIGHT] = GeometryPtr(new MeshGeometry(generateStraight(specs), GL_STATIC_DRAW, true));
+    geometries[RoadTileTypes::CURVE] = GeometryPtr(new MeshGeometry(generateCurve(specs), GL_STATIC_DRAW, true));
+    geometries[RoadTileTypes::T_CROSSING] = GeometryPtr(new MeshGeometry(generateTCrossing(specs), GL_STATIC_DRAW, true));
+    geometries[RoadTileTypes::CROSSING] = GeometryPtr(new MeshGeometry(generateCrossing(specs), GL_STATIC_DRAW, true));
+    geometries[RoadTileTypes::END] = GeometryPtr(new MeshGeometry(generateEnd(specs), GL_STATIC_DRAW, true));
+    geometries[RoadTileTypes::RAMP] = GeometryPtr(new MeshGeometry(generateRamp(specs), GL_STATIC_DRAW, true));
 
     return geometries;
 }
@@ -15,11 +15,14 @@
  */
 #include "systems/buildSystem.hpp"
 
+#include "application.hpp"
 #include "components/components.hpp"
 #include "events/events.hpp"
 
+#include "misc/profiler.hpp"
 #include "resources/object.hpp"
 #include "resources/roadPack.hpp"
+#include "systems/hierarchySystem.hpp"
 
 #include "misc/coordinateTransform.hpp"
 #include "misc/ray.hpp"
@@ -37,6 +40,10 @@ bool BuildSystem::GridMouseIntersection::positionUpdated() const {
 
 BuildSystem::BuildSystem(Game* game)
     : System(game) {
+    // creates the building previews and raises the build events, whose handlers change most of the chunk components
+    access.mainThread = true;
+    access.structural = true;
+
     init();
 
     eventDispatcher.sink<MouseButtonEvent>()
@@ -50,6 +57,12 @@ BuildSystem::BuildSystem(Game* game)
 
     eventDispatcher.sink<MouseMoveEvent>()
         .connect<&BuildSystem::handleMouseMoveEvent>(*this);
+
+    registry.on_destroy<BuildingComponent>()
+        .connect<&BuildSystem::removeFromGrid>(*this);
+
+    registry.on_destroy<ParkingComponent>()
+        .connect<&BuildSystem::removeParkedCars>(*this);
 }
 
 void BuildSystem::init() {
@@ -59,6 +72,7 @@ void BuildSystem::init() {
 }
 
 void BuildSystem::update(float dt) {
+    PROFILE_FUNCTION();
     if (game->getState() != GameState::BUILD_MODE) {
         return;
     }
@@ -113,6 +127,8 @@ void BuildSystem::update(float dt) {
 
         BuildingComponent& building = registry.get<BuildingComponent>(objectToBuild);
         building.preview = false;
+        addToGrid(objectToBuild, building);
+        parkCars(objectToBuild);
 
         objectsToBuild.pop();
     }
@@ -176,12 +192,92 @@ constexpr glm::ivec2 BuildSystem::getDefaultSize(BuildingType type) {
     }
 }
 
-bool BuildSystem::canBuild(const std::vector<glm::ivec2>& positions, const BuildingType type, const TerrainComponent& terrain) const {
-    // TODO: Implement this when returning to non flat terrain
+bool BuildSystem::canBuild(const std::vector<glm::ivec2>& positions, const BuildingType type) const {
+    // TODO: Check the terrain when returning to non flat terrain
+    switch (type) {
+        case BuildingType::NONE:
+        case BuildingType::CLEAR:
+        case BuildingType::ROAD:
+            return true;
+        default:
+            break;
+    }
+
+    // buildings must not overlap other buildings
+    const glm::ivec2 min = glm::min(positions.front(), positions.back());
+    const glm::ivec2 max = glm::max(positions.front(), positions.back());
+    for (int x = min.x; x <= max.x; x++) {
+        for (int y = min.y; y <= max.y; y++) {
+            const bool occupied = game->terrain.grid.any(glm::ivec2(x, y), [&](const GridItem& item) {
+                return !item.isInstance() && registry.all_of<BuildingComponent>(item.entity);
+            });
+
+            if (occupied) {
+                return false;
+            }
+        }
+    }
 
     return true;
 }
 
+std::vector<glm::ivec2> BuildSystem::getFootprint(const BuildingComponent& building) {
+    const glm::ivec2 size = glm::max(glm::ivec2(glm::ceil(building.size)), glm::ivec2(1));
+
+    std::vector<glm::ivec2> cells;
+    cells.reserve(size.x * size.y);
+    for (int x = 0; x < size.x; x++) {
+        for (int y = 0; y < size.y; y++) {
+            cells.push_back(building.gridPosition + glm::ivec2(x, y));
+        }
+    }
+
+    return cells;
+}
+
+void BuildSystem::addToGrid(entt::entity entity, const BuildingComponent& building) const {
+    for (const glm::ivec2& cell : getFootprint(building)) {
+        game->terrain.grid.insert(cell, GridItem{entity});
+    }
+}
+
+void BuildSystem::removeFromGrid(entt::registry& registry, entt::entity entity) const {
+    const BuildingComponent& building = registry.get<BuildingComponent>(entity);
+    if (building.preview) {
+        return;
+    }
+
+    for (const glm::ivec2& cell : getFootprint(building)) {
+        game->terrain.grid.remove(cell, GridItem{entity});
+    }
+}
+
+void BuildSystem::parkCars(entt::entity lot) {
+    ParkingComponent* parking = registry.try_get<ParkingComponent>(lot);
+    if (parking == nullptr) {
+        return;
+    }
+
+    ObjectPtr car = resourceManager.getResource<Object>("object.car");
+    const std::vector<entt::entity> cars = car->create(registry, parking->parkingSpots->size());
+
+    for (std::size_t spot = 0; spot < cars.size(); spot++) {
+        // the position of the spot is relative to the parking lot
+        registry.emplace<TransformationComponent>(cars[spot], (*parking->parkingSpots)[spot].position);
+        HierarchySystem::setParent(registry, cars[spot], lot);
+
+        parking->occupants[spot] = cars[spot];
+    }
+}
+
+void BuildSystem::removeParkedCars(entt::registry& registry, entt::entity lot) const {
+    for (const entt::entity car : registry.get<ParkingComponent>(lot).occupants) {
+        if (registry.valid(car)) {
+            registry.destroy(car);
+        }
+    }
+}
+
 constexpr glm::vec3 BuildSystem::getBuildingOffset(const BuildingType type) {
     switch (type) {
         case BuildingType::ROAD:
@@ -245,13 +341,17 @@ void BuildSystem::handleMouseButtonEvent(const MouseButtonEvent& e) {
                                                 : std::vector<glm::ivec2>{building.gridPosition, building.gridPosition + glm::ivec2(glm::ceil(building.size - glm::vec2(1.0f)))};
         entt::entity entityToBuild = currentBuilding;
 
-        bool canBuild;
         switch (building.type) {
             case BuildingType::ROAD:
                 // do not add the builded road to the building queue. The building process is handled by the road system
                 createNewBuilding();
                 break;
             default:
+                if (!canBuild(positions, building.type)) {
+                    game->getApp()->getGui()->showWarning("Invalid build position!");
+                    return;
+                }
+
                 objectsToBuild.emplace(currentBuilding);
                 createNewBuilding();
                 break;
@@ -19,6 +19,7 @@
 #include "events/cameraUpdateEvent.hpp"
 
 #include "misc/coordinateTransform.hpp"
+#include "misc/profiler.hpp"
 
 #include <GLFW/glfw3.h>
 #include <iostream>
@@ -32,14 +33,36 @@ void CameraSystem::init() {
 
 CameraSystem::CameraSystem(Game* game)
     : System(game) {
+    // reads the input of the window. The render system updates the shadow cascades on camera updates
+    access.mainThread = true;
+    access.read<TerrainComponent>().write<CameraComponent, TransformationComponent, SunLightComponent>();
 
     init();
 
     eventDispatcher.sink<FramebufferSizeEvent>()
         .connect<&CameraSystem::onFramebufferSize>(*this);
+
+    eventDispatcher.sink<KeyEvent>()
+        .connect<&CameraSystem::handleKeyEvent>(*this);
 }
 
 void CameraSystem::update(float dt) {
+    PROFILE_FUNCTION();
+    if (playing) {
+        updatePlayback(dt);
+        return;
+    }
+
+    if (recording) {
+        pathTime += dt;
+        recordTimer += dt;
+
+        if (recordTimer >= Configuration::cameraPathRecordInterval) {
+            recordTimer -= Configuration::cameraPathRecordInterval;
+            recordKeyframe();
+        }
+    }
+
     CameraComponent& camera = registry.get<CameraComponent>(cameraEntity);
     TransformationComponent& transform = registry.get<TransformationComponent>(cameraEntity);
 
@@ -102,6 +125,71 @@ void CameraSystem::update(float dt) {
     }
 }
 
+void CameraSystem::updatePlayback(float dt) {
+    pathTime += dt;
+    const CameraKeyframe keyframe = path.sample(pathTime);
+
+    CameraComponent& camera = registry.get<CameraComponent>(cameraEntity);
+    TransformationComponent& transform = registry.get<TransformationComponent>(cameraEntity);
+
+    transform.position = keyframe.position;
+    camera.yaw = keyframe.yaw;
+    camera.pitch = keyframe.pitch;
+    camera.calculateMatrices(transform);
+
+    CameraUpdateEvent event{cameraEntity, false, true, true};
+    game->raiseEvent<CameraUpdateEvent>(event);
+
+    if (pathTime >= path.getDuration()) {
+        playing = false;
+    }
+}
+
+void CameraSystem::recordKeyframe() {
+    const CameraComponent& camera = registry.get<CameraComponent>(cameraEntity);
+    const TransformationComponent& transform = registry.get<TransformationComponent>(cameraEntity);
+
+    path.addKeyframe(CameraKeyframe{pathTime, transform.position, camera.yaw, camera.pitch});
+}
+
+void CameraSystem::startRecording() {
+    path.clear();
+    pathTime = 0.0f;
+    recordTimer = 0.0f;
+    recording = true;
+
+    recordKeyframe();
+    std::cout << "CAMERA_SYSTEM: Recording camera path" << std::endl;
+}
+
+void CameraSystem::stopRecording() {
+    recordKeyframe();
+    recording = false;
+
+    if (path.save(Configuration::cameraPathFile)) {
+        std::cout << "CAMERA_SYSTEM: Camera path written to " << Configuration::cameraPathFile << std::endl;
+    }
+}
+
+void CameraSystem::playPath(const CameraPath& path) {
+    this->path = path;
+    pathTime = 0.0f;
+    recording = false;
+    playing = !path.empty();
+}
+
+void CameraSystem::handleKeyEvent(const KeyEvent& e) {
+    // record the camera path
+    if (e.key == GLFW_KEY_F7 && e.action == GLFW_PRESS && !playing) {
+        if (recording) {
+            stopRecording();
+        }
+        else {
+            startRecording();
+        }
+    }
+}
+
 void CameraSystem::onFramebufferSize(const FramebufferSizeEvent& e) {
     CameraComponent& camera = registry.get<CameraComponent>(cameraEntity);
     const TransformationComponent& cameraTransform = registry.get<TransformationComponent>(cameraEntity);
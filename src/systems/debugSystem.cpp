@@ -16,6 +16,7 @@
 #include "systems/debugSystem.hpp"
 
 #include "components/components.hpp"
+#include "misc/profiler.hpp"
 #include "resources/mesh.hpp"
 
 #include "GL/glew.h"
@@ -57,6 +58,7 @@ DebugSystem::~DebugSystem() {
 }
 
 void DebugSystem::update(float dt) {
+    PROFILE_FUNCTION();
 }
 
 void DebugSystem::handleKeyEvent(const KeyEvent& e) {
@@ -15,6 +15,8 @@
  */
 #include "systems/environmentSystem.hpp"
 
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
 #include "rendering/geometry.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/texture.hpp"
@@ -25,21 +27,30 @@
 #include "misc/configuration.hpp"
 #include "misc/coordinateTransform.hpp"
 #include "misc/utility.hpp"
+#include "systems/terrainSystem.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <format>
+#include <random>
 
 EnvironmentSystem::EnvironmentSystem(Game* game)
     : System(game) {
+    // destroys the entities of cleared cells and fills the instance buffers of the trees
+    access.mainThread = true;
+    access.structural = true;
+    access.runAfter<TerrainSystem>();
+
     init();
 
     eventDispatcher.sink<BuildEvent>()
         .connect<&EnvironmentSystem::handleBuildEvent>(*this);
 
-    eventDispatcher.sink<ChunkCreatedEvent>()
-        .connect<&EnvironmentSystem::handleChunkCreatedEvent>(*this);
+    eventDispatcher.sink<EventBatch<ChunkCreatedEvent>>()
+        .connect<&EnvironmentSystem::handleChunksCreated>(*this);
 }
 
 void EnvironmentSystem::init() {
@@ -57,8 +68,7 @@ void EnvironmentSystem::init() {
                                               glm::vec3(50.0f));
     registry.emplace<MeshComponent>(game->sun, resourceManager.getResource<Mesh<>>("SUN_MESH"));
 
-    EntityMoveEvent moveEvent{game->sun};
-    game->raiseEvent(moveEvent);
+    game->postEvent(EntityMoveEvent{game->sun});
 }
 
 void EnvironmentSystem::updateDayNightCycle(float dt, TransformationComponent& sunTransform, SunLightComponent& sun) const {
@@ -91,8 +101,7 @@ void EnvironmentSystem::updateDayNightCycle(float dt, TransformationComponent& s
     sunTransform.rotation = glm::quat(glm::cos(sun.angle / 2), 0, 0, glm::sin(sun.angle / 2));
     sunTransform.calculateTransform();
 
-    EntityMoveEvent e{game->sun};
-    game->raiseEvent(e);
+    game->postEvent(EntityMoveEvent{game->sun});
 }
 
 void EnvironmentSystem::destroyEntities() {
@@ -107,40 +116,60 @@ void EnvironmentSystem::destroyEntities() {
     }
 }
 
+glm::ivec2 EnvironmentSystem::getInstanceCell(const glm::mat4& transform, const glm::mat4& instance) {
+    const glm::vec3 position = glm::vec3(transform * instance[3]);
+
+    return glm::floor(utility::worldToNormalizedWorldGridCoords(position));
+}
+
 void EnvironmentSystem::clearCells() {
+    SpatialGrid& grid = game->terrain.grid;
+
     while (cellsToClear.size() > 0) {
-        const glm::ivec2& position = cellsToClear.front();
+        const glm::ivec2 position = cellsToClear.front();
+        cellsToClear.pop();
 
-        registry.view<EnvironmentComponent, InstancedMeshComponent, TransformationComponent>()
-            .each([&](const EnvironmentComponent& environment, InstancedMeshComponent& instancedMesh, const TransformationComponent& transformation) {
-                auto it = instancedMesh.transformations.begin();
-                bool needsUpdate = false;
+        std::vector<GridItem> items;
+        for (const GridItem& item : grid.query(position)) {
+            if (item.isInstance() && registry.all_of<EnvironmentComponent, MultiInstancedMeshComponent>(item.entity)) {
+                items.push_back(item);
+            }
+        }
 
-                while (it != instancedMesh.transformations.end()) {
-                    const glm::vec3& objectPosition = it->operator[](3);
-                    const glm::ivec2 gridPosition = glm::floor(utility::worldToNormalizedWorldGridCoords(objectPosition));
+        // the last instance is moved into the removed slot, so the highest indices are removed first to keep the other indices valid
+        std::sort(items.begin(), items.end(), [](const GridItem& lhs, const GridItem& rhs) {
+            return lhs.instance > rhs.instance;
+        });
 
-                    if (gridPosition == position) {
-                        it = instancedMesh.transformations.erase(it);
-                        needsUpdate = true;
-                    }
-                    else {
-                        it++;
-                    }
-                }
+        for (const GridItem& item : items) {
+            auto&& [mesh, transform] = registry.get<MultiInstancedMeshComponent, TransformationComponent>(item.entity);
+            InstancedMesh<glm::mat4>& instances = mesh.transforms.at(item.instances);
 
-                instancedMesh.instanceBuffer.fillBuffer(instancedMesh.transformations);
-            });
-        cellsToClear.pop();
+            grid.remove(position, item);
+
+            const unsigned int last = instances.transformations.size() - 1;
+            instances.removeInstance(item.instance);
+
+            if (item.instance != last) {
+                const glm::ivec2 movedCell = getInstanceCell(transform.transform, instances.transformations[item.instance]);
+                grid.replace(movedCell, GridItem{item.entity, item.instances, last}, item);
+            }
+
+            if (InstanceCullingComponent* culling = registry.try_get<InstanceCullingComponent>(item.entity)) {
+                culling->boundsOutdated = true;
+            }
+        }
     }
 }
 
 void EnvironmentSystem::update(float dt) {
-    // TODO: Optimize this
+    PROFILE_FUNCTION();
     clearCells();
 
     destroyEntities();
 
+    finishScatterTasks();
+
     SunLightComponent& sunLight = registry.get<SunLightComponent>(game->sun);
     TransformationComponent& sunTransform = registry.get<TransformationComponent>(game->sun);
     updateDayNightCycle(dt, sunTransform, sunLight);
@@ -165,34 +194,64 @@ void EnvironmentSystem::handleBuildEvent(const BuildEvent& e) {
                 }
             } break;
             case BuildShape::AREA: {
+                const glm::ivec2 min = glm::min(e.positions[0], e.positions[1]);
+                const glm::ivec2 max = glm::max(e.positions[0], e.positions[1]);
+
+                for (int x = min.x; x <= max.x; x++) {
+                    for (int y = min.y; y <= max.y; y++) {
+                        cellsToClear.emplace(x, y);
+                    }
+                }
             } break;
         }
     }
 }
 
-void EnvironmentSystem::handleChunkCreatedEvent(const ChunkCreatedEvent& e) const {
-    MeshPtr treeMesh = resourceManager.getResource<Mesh<>>("TREE_MESH");
-    const TerrainComponent& terrain = registry.get<TerrainComponent>(e.entity);
-    std::unordered_map<std::string, InstancedMesh<glm::mat4>> transformations;
+void EnvironmentSystem::handleChunksCreated(const EventBatch<ChunkCreatedEvent>& batch) {
+    for (const ChunkCreatedEvent& e : batch.events) {
+        const TerrainComponent& terrain = registry.get<TerrainComponent>(e.entity);
+
+        // the trees are placed on a worker thread and added to the chunk when they are ready
+        scatterTasks.emplace_back(e.entity, JobSystem::get().async([chunkPosition = e.chunkPosition, seed = game->terrain.seed, heightValues = terrain.heightValues, surfaceTypes = terrain.surfaceTypes]() {
+            return scatterTrees(chunkPosition, seed, heightValues, surfaceTypes);
+        }));
+    }
+}
+
+EnvironmentSystem::TreeTransforms EnvironmentSystem::scatterTrees(const glm::ivec2& chunkPosition, unsigned int seed, float** const heightValues, TerrainSurfaceTypes** const surfaceTypes) {
+    PROFILE_FUNCTION();
+    TreeTransforms transformations;
 
     const std::array<std::string, 2> treeNames = {"tree01", "tree02"};
 
+    // the trees of a chunk only depend on the seed and the chunk position, not on the order in which the chunks are created
+    std::seed_seq seedSequence{seed, static_cast<unsigned int>(chunkPosition.x), static_cast<unsigned int>(chunkPosition.y)};
+    std::mt19937 random(seedSequence);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
     // spawn trees
     for (int i = 0; i < 100; i++) {
-        glm::vec2 chunkGridPos = Configuration::cellsPerChunk / static_cast<float>(RAND_MAX) * glm::vec2(rand(), rand());
-        const glm::vec2& gridPos = utility::normalizedChunkGridToNormalizedWorldGridCoords(e.chunkPosition, chunkGridPos);
+        const float x = distribution(random);
+        const float y = distribution(random);
+        glm::vec2 chunkGridPos = static_cast<float>(Configuration::cellsPerChunk) * glm::vec2(x, y);
+        const glm::ivec2 cell = glm::floor(chunkGridPos);
 
-        TerrainSurfaceTypes surfaceType = game->terrain.getSurfaceType(gridPos);
+        // the position lies inside of the chunk, so only its own height values are needed
+        TerrainSurfaceTypes surfaceType = surfaceTypes[cell.x][cell.y];
         if (surfaceType == TerrainSurfaceTypes::GRASS) {
-            glm::vec3 position = glm::vec3(Configuration::cellSize * chunkGridPos.x, game->terrain.getTerrainHeight(gridPos), Configuration::cellSize * chunkGridPos.y);
-            float angle = (float)rand() / static_cast<float>(RAND_MAX) * 0.5f * glm::pi<float>();
-            glm::vec3 scale = glm::vec3((float)rand() / static_cast<float>(RAND_MAX) * 0.5 + 1.5f);
-            int type = rand() % 2;
+            const glm::vec2 cellPos = chunkGridPos - glm::vec2(cell);
+            const float x0 = glm::mix(heightValues[cell.x][cell.y], heightValues[cell.x + 1][cell.y], cellPos.x);
+            const float x1 = glm::mix(heightValues[cell.x][cell.y + 1], heightValues[cell.x + 1][cell.y + 1], cellPos.x);
+
+            glm::vec3 position = glm::vec3(Configuration::cellSize * chunkGridPos.x, glm::mix(x0, x1, cellPos.y), Configuration::cellSize * chunkGridPos.y);
+            float angle = distribution(random) * 0.5f * glm::pi<float>();
+            glm::vec3 scale = glm::vec3(distribution(random) * 0.5f + 1.5f);
+            int type = distribution(random) < 0.5f ? 0 : 1;
 
             float cosAngle = glm::cos(angle);
             float sinAngle = glm::sin(angle);
 
-            transformations[treeNames[type]].transformations.emplace_back(
+            transformations[treeNames[type]].emplace_back(
                 glm::vec4(scale.x * cosAngle, 0, -scale.x * sinAngle, 0),
                 glm::vec4(0, scale.y, 0, 0),
                 glm::vec4(scale.z * sinAngle, 0, scale.z * cosAngle, 0),
@@ -200,10 +259,37 @@ void EnvironmentSystem::handleChunkCreatedEvent(const ChunkCreatedEvent& e) cons
         }
     }
 
-    for (auto& [name, instancedMesh] : transformations) {
-        instancedMesh.instanceBuffer.fillBuffer(instancedMesh.transformations);
-    }
+    return transformations;
+}
 
-    MultiInstancedMeshComponent& instancedMesh = registry.emplace<MultiInstancedMeshComponent>(e.entity, treeMesh, transformations);
-    registry.emplace<EnvironmentComponent>(e.entity);
+void EnvironmentSystem::finishScatterTasks() {
+    MeshPtr treeMesh = resourceManager.getResource<Mesh<>>("TREE_MESH");
+
+    for (auto it = scatterTasks.begin(); it != scatterTasks.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            it++;
+            continue;
+        }
+
+        std::unordered_map<std::string, InstancedMesh<glm::mat4>> transformations;
+        for (auto& [name, treeTransforms] : it->second.get()) {
+            InstancedMesh<glm::mat4>& instancedMesh = transformations[name];
+            instancedMesh.transformations = std::move(treeTransforms);
+            instancedMesh.instanceBuffer.fillBuffer(instancedMesh.transformations);
+        }
+
+        const MultiInstancedMeshComponent& mesh = registry.emplace<MultiInstancedMeshComponent>(it->first, treeMesh, transformations);
+        registry.emplace<InstanceCullingComponent>(it->first);
+        registry.emplace<EnvironmentComponent>(it->first);
+
+        // the trees are indexed by the cell they are rendered in
+        const glm::mat4& chunkTransform = registry.get<TransformationComponent>(it->first).transform;
+        for (const auto& [name, instances] : mesh.transforms) {
+            for (unsigned int i = 0; i < instances.transformations.size(); i++) {
+                game->terrain.grid.insert(getInstanceCell(chunkTransform, instances.transformations[i]), GridItem{it->first, name, i});
+            }
+        }
+
+        it = scatterTasks.erase(it);
+    }
 }
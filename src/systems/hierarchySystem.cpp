@@ -0,0 +1,135 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "systems/hierarchySystem.hpp"
+
+#include "components/components.hpp"
+#include "misc/profiler.hpp"
+
+#include <glm/gtx/matrix_decompose.hpp>
+
+#include <cassert>
+#include <vector>
+
+HierarchySystem::HierarchySystem(Game* game)
+    : System(game) {
+    access.write<ParentComponent, TransformationComponent>();
+
+    registry.on_construct<ParentComponent>().connect<&HierarchySystem::onHierarchyChanged>(*this);
+    registry.on_update<ParentComponent>().connect<&HierarchySystem::onHierarchyChanged>(*this);
+}
+
+void HierarchySystem::onHierarchyChanged(entt::registry&, entt::entity) {
+    sortRequired = true;
+}
+
+void HierarchySystem::sortHierarchy() {
+    PROFILE_FUNCTION();
+    const auto& parents = registry.storage<ParentComponent>();
+
+    // reparenting moves the whole subtree, so the depths are counted again
+    registry.view<ParentComponent>().each([&](ParentComponent& hierarchy) {
+        hierarchy.depth = 1;
+
+        entt::entity ancestor = hierarchy.parent;
+        while (parents.contains(ancestor)) {
+            hierarchy.depth++;
+            ancestor = parents.get(ancestor).parent;
+        }
+    });
+
+    registry.sort<ParentComponent>([](const ParentComponent& lhs, const ParentComponent& rhs) {
+        return lhs.depth < rhs.depth;
+    });
+
+    sortRequired = false;
+}
+
+void HierarchySystem::update(float dt) {
+    PROFILE_FUNCTION();
+    if (sortRequired) {
+        sortHierarchy();
+    }
+
+    auto& transforms = registry.storage<TransformationComponent>();
+    std::vector<entt::entity> orphans;
+
+    // parents precede their children, so the matrix of the parent is up to date when a child is visited
+    registry.view<ParentComponent>().each([&](const entt::entity entity, ParentComponent& hierarchy) {
+        if (!transforms.contains(hierarchy.parent)) {
+            orphans.push_back(entity);
+            return;
+        }
+
+        TransformationComponent& transform = transforms.get(entity);
+        const TransformationComponent& parentTransform = transforms.get(hierarchy.parent);
+
+        // the matrix was changed by someone else or the position, rotation or scale changed
+        const bool localChanged = transform.dirty || transform.version != hierarchy.version;
+        if (!localChanged && parentTransform.version == hierarchy.parentVersion) {
+            return;
+        }
+
+        if (localChanged) {
+            hierarchy.localTransform = transform.calculateMatrix();
+        }
+
+        transform.setTransform(parentTransform.transform * hierarchy.localTransform);
+        transform.dirty = false;
+
+        hierarchy.version = transform.version;
+        hierarchy.parentVersion = parentTransform.version;
+    });
+
+    // entities whose parent was destroyed stay where they are
+    for (const entt::entity entity : orphans) {
+        removeParent(registry, entity);
+    }
+}
+
+bool HierarchySystem::setParent(entt::registry& registry, entt::entity entity, entt::entity parent) {
+    assert(registry.all_of<TransformationComponent>(entity) && registry.all_of<TransformationComponent>(parent));
+
+    // a cycle would never end the depth calculation
+    for (entt::entity ancestor = parent; ancestor != entt::null;) {
+        if (ancestor == entity) {
+            return false;
+        }
+
+        const ParentComponent* hierarchy = registry.try_get<ParentComponent>(ancestor);
+        ancestor = hierarchy != nullptr ? hierarchy->parent : entt::null;
+    }
+
+    // the transformation is interpreted relative to the parent from now on
+    registry.emplace_or_replace<ParentComponent>(entity, parent);
+    registry.get<TransformationComponent>(entity).dirty = true;
+
+    return true;
+}
+
+void HierarchySystem::removeParent(entt::registry& registry, entt::entity entity) {
+    if (!registry.all_of<ParentComponent>(entity)) {
+        return;
+    }
+
+    registry.remove<ParentComponent>(entity);
+
+    // the world matrix becomes the transformation of the entity
+    TransformationComponent& transform = registry.get<TransformationComponent>(entity);
+    glm::vec3 skew;
+    glm::vec4 perspective;
+    glm::decompose(transform.transform, transform.scale, transform.rotation, transform.position, skew, perspective);
+    transform.calculateTransform();
+}
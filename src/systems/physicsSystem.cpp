@@ -16,30 +16,91 @@
 #include "systems/physicsSystem.hpp"
 
 #include "components/components.hpp"
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
 
 PhysicsSystem::PhysicsSystem(Game* game)
     : System(game) {
+    access.write<TransformationComponent, VelocityComponent>();
 }
 
 void PhysicsSystem::init() {
 }
 
 void PhysicsSystem::update(float dt) {
-    registry.view<TransformationComponent, VelocityComponent>().each(
-        [&](TransformationComponent& transform, VelocityComponent& movement) {
-            // apply translation
-            // dr = v dt
-            transform.position += movement.linearVelocity * dt;
-
-            // apply rotation
-            if (glm::length(movement.angularVelocity) > 0) {
-                glm::quat dPhi = glm::angleAxis(glm::length(movement.angularVelocity) * dt, glm::normalize(movement.angularVelocity));
+    PROFILE_FUNCTION();
+    auto& velocities = registry.storage<VelocityComponent>();
+    auto& transforms = registry.storage<TransformationComponent>();
+
+    // the bodies are split by their index in the velocity storage. Every job only changes the components of its own bodies
+    JobSystem::get().parallelFor(0, velocities.size(), bodiesPerJob, [&velocities, &transforms, dt](std::size_t first, std::size_t last) {
+        Bodies bodies;
+        for (std::size_t i = first; i < last; i++) {
+            const entt::entity entity = velocities.data()[i];
+            if (!transforms.contains(entity)) {
+                continue;
+            }
+
+            TransformationComponent& transform = transforms.get(entity);
+            VelocityComponent& movement = velocities.get(entity);
+
+            // rotating bodies are integrated one by one, because the rotation changes their velocity
+            if (movement.angularVelocity != glm::vec3(0.0f)) {
+                const float angularSpeed = glm::length(movement.angularVelocity);
+                const glm::quat dPhi = glm::angleAxis(angularSpeed * dt, movement.angularVelocity / angularSpeed);
+
+                transform.position += movement.linearVelocity * dt;
                 transform.rotation *= dPhi;
+                transform.dirty = true;
+
+                movement.linearVelocity = dPhi * movement.linearVelocity;
+                continue;
+            }
 
-                glm::mat3 rotation = glm::toMat3(dPhi);
-                movement.linearVelocity = rotation * movement.linearVelocity;
+            // resting bodies keep their matrix
+            if (movement.linearVelocity == glm::vec3(0.0f)) {
+                continue;
             }
 
-            transform.calculateTransform();
-        });
+            const std::size_t index = bodies.count++;
+            bodies.entities[index] = entity;
+            bodies.positionX[index] = transform.position.x;
+            bodies.positionY[index] = transform.position.y;
+            bodies.positionZ[index] = transform.position.z;
+            bodies.velocityX[index] = movement.linearVelocity.x;
+            bodies.velocityY[index] = movement.linearVelocity.y;
+            bodies.velocityZ[index] = movement.linearVelocity.z;
+        }
+
+        integrate(bodies, dt);
+
+        for (std::size_t i = 0; i < bodies.count; i++) {
+            TransformationComponent& transform = transforms.get(bodies.entities[i]);
+            transform.position = glm::vec3(bodies.positionX[i], bodies.positionY[i], bodies.positionZ[i]);
+            // the matrix is calculated by the interpolation of the frame
+            transform.dirty = true;
+        }
+    });
+}
+
+void PhysicsSystem::integrate(Bodies& bodies, float dt) {
+    // dr = v dt
+    float* const positionX = bodies.positionX.data();
+    float* const positionY = bodies.positionY.data();
+    float* const positionZ = bodies.positionZ.data();
+    const float* const velocityX = bodies.velocityX.data();
+    const float* const velocityY = bodies.velocityY.data();
+    const float* const velocityZ = bodies.velocityZ.data();
+
+    for (std::size_t i = 0; i < bodies.count; i++) {
+        positionX[i] += velocityX[i] * dt;
+    }
+
+    for (std::size_t i = 0; i < bodies.count; i++) {
+        positionY[i] += velocityY[i] * dt;
+    }
+
+    for (std::size_t i = 0; i < bodies.count; i++) {
+        positionZ[i] += velocityZ[i] * dt;
+    }
 }
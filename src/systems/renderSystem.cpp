@@ -15,6 +15,8 @@
  */
 #include "systems/renderSystem.hpp"
 
+#include "application.hpp"
+
 #include "events/framebufferSizeEvent.hpp"
 #include "events/keyEvent.hpp"
 #include "events/mouseEvents.hpp"
@@ -22,8 +24,13 @@
 #include "components/components.hpp"
 
 #include "misc/configuration.hpp"
+#include "misc/frustum.hpp"
+#include "misc/profiler.hpp"
+#include "rendering/renderStats.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <numeric>
 
 #include <GL/glew.h>
@@ -51,126 +58,477 @@ void RenderSystem::init() {
 
 RenderSystem::RenderSystem(Game* game)
     : System(game) {
+    access.mainThread = true;
+    access.read<CameraComponent, TransformationComponent, SunLightComponent, OccluderComponent, BuildingComponent, TerrainComponent, MultiInstancedMeshComponent, RoadMeshComponent, StaticBatchComponent, StaticBatchedComponent, DebugComponent>()
+        .write<MeshComponent, InstancedMeshComponent, InstanceCullingComponent>();
+
     init();
 
     // connect event handlers
     eventDispatcher.sink<CameraUpdateEvent>()
         .connect<&RenderSystem::onCameraUpdated>(*this);
 
-    eventDispatcher.sink<EntityMoveEvent>()
-        .connect<&RenderSystem::onEntityMoved>(*this);
+    eventDispatcher.sink<EventBatch<EntityMoveEvent>>()
+        .connect<&RenderSystem::onEntitiesMoved>(*this);
 }
 
 void RenderSystem::onCameraUpdated(CameraUpdateEvent& event) const {
-    // get components and calculate camera target
-    const entt::entity& cameraEntity = event.entity;
-    const CameraComponent& camera = registry.get<CameraComponent>(cameraEntity);
-    const TransformationComponent& cameraTransform = registry.get<TransformationComponent>(cameraEntity);
-
-    const glm::vec3& cameraTarget = cameraTransform.position + camera.front;
-
-    // bind camera buffer to location 1
-    glBindBufferBase(GL_UNIFORM_BUFFER, 1, uboCamera);
-    // view matrix
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(camera.viewMatrix));
-    // projection matrix
-    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(camera.projectionMatrix));
-    // camera position
-    glBufferSubData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), sizeof(glm::vec3), glm::value_ptr(cameraTransform.position));
-    // camera target
-    glBufferSubData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4) + sizeof(glm::vec4), sizeof(glm::vec3), glm::value_ptr(cameraTarget));
-
+    // the buffers are updated when the snapshot is submitted
     if (game->sun != entt::null) {
+        const CameraComponent& camera = registry.get<CameraComponent>(event.entity);
         SunLightComponent& sunLight = registry.get<SunLightComponent>(game->sun);
         sunLight.calculateLightMatrices(camera);
-        updateLightBuffer(sunLight, camera);
     }
 }
 
-void RenderSystem::onEntityMoved(EntityMoveEvent& event) const {
-    // update sun uniform buffer
-    if (event.entity == game->sun) {
-        const CameraComponent& camera = registry.get<CameraComponent>(game->camera);
-        SunLightComponent& sunLight = registry.get<SunLightComponent>(game->sun);
+void RenderSystem::onEntitiesMoved(const EventBatch<EntityMoveEvent>& batch) const {
+    // update sun light matrices. The movements are coalesced, so the sun appears at most once
+    for (const EntityMoveEvent& event : batch.events) {
+        if (event.entity == game->sun) {
+            const CameraComponent& camera = registry.get<CameraComponent>(game->camera);
+            SunLightComponent& sunLight = registry.get<SunLightComponent>(game->sun);
 
-        // recalculate matrices and update light buffer
-        sunLight.calculateLightMatrices(camera);
-        updateLightBuffer(sunLight, camera);
+            sunLight.calculateLightMatrices(camera);
+        }
     }
 }
 
-void RenderSystem::updateLightBuffer(const LightComponent& sunLight, const CameraComponent& camera) const {
+void RenderSystem::updateCameraBuffer() const {
+    // bind camera buffer to location 1
+    glBindBufferBase(GL_UNIFORM_BUFFER, 1, uboCamera);
+    // view matrix
+    counted::bufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(snapshot.viewMatrix));
+    // projection matrix
+    counted::bufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(snapshot.projectionMatrix));
+    // camera position
+    counted::bufferSubData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), sizeof(glm::vec3), glm::value_ptr(snapshot.cameraPosition));
+    // camera target
+    counted::bufferSubData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4) + sizeof(glm::vec4), sizeof(glm::vec3), glm::value_ptr(snapshot.cameraTarget));
+}
+
+void RenderSystem::updateLightBuffer() const {
     glBindBufferBase(GL_UNIFORM_BUFFER, 2, uboLight);
     for (int i = 0; i < Configuration::SHADOW_CASCADE_COUNT; i++) {
         // light view
-        glBufferSubData(GL_UNIFORM_BUFFER, i * sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(sunLight.lightView[i]));
+        counted::bufferSubData(GL_UNIFORM_BUFFER, i * sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(snapshot.lightView[i]));
         // light projection
-        glBufferSubData(GL_UNIFORM_BUFFER, (Configuration::SHADOW_CASCADE_COUNT + i) * sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(sunLight.lightProjection[i]));
+        counted::bufferSubData(GL_UNIFORM_BUFFER, (Configuration::SHADOW_CASCADE_COUNT + i) * sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(snapshot.lightProjection[i]));
         // cascade far planes
-        float value = (camera.far - camera.near) * Configuration::CASCADE_FAR_PLANE_FACTORS[i] + camera.near;
-        glBufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4) + (4 + i) * sizeof(glm::vec4), sizeof(float), &value);
+        counted::bufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4) + (4 + i) * sizeof(glm::vec4), sizeof(float), &snapshot.cascadeFarPlanes[i]);
     }
     // light direction
-    glBufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4), sizeof(glm::vec3), glm::value_ptr(sunLight.direction));
+    counted::bufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4), sizeof(glm::vec3), glm::value_ptr(snapshot.lightDirection));
     // light ambient
-    glBufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4) + sizeof(glm::vec4), sizeof(glm::vec3), glm::value_ptr(sunLight.ambient));
+    counted::bufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4) + sizeof(glm::vec4), sizeof(glm::vec3), glm::value_ptr(snapshot.lightAmbient));
     // light diffuse
-    glBufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4) + 2 * sizeof(glm::vec4), sizeof(glm::vec3), glm::value_ptr(sunLight.diffuse));
+    counted::bufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4) + 2 * sizeof(glm::vec4), sizeof(glm::vec3), glm::value_ptr(snapshot.lightDiffuse));
     // light specular
-    glBufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4) + 3 * sizeof(glm::vec4), sizeof(glm::vec3), glm::value_ptr(sunLight.specular));
+    counted::bufferSubData(GL_UNIFORM_BUFFER, 2 * Configuration::SHADOW_CASCADE_COUNT * sizeof(glm::mat4) + 3 * sizeof(glm::vec4), sizeof(glm::vec3), glm::value_ptr(snapshot.lightSpecular));
+}
+
+void RenderSystem::cullInstances() const {
+    PROFILE_FUNCTION();
+    const auto& [camera, cameraTransform] = registry.get<CameraComponent, TransformationComponent>(game->camera);
+    const SunLightComponent& sun = registry.get<SunLightComponent>(game->sun);
+
+    const Frustum cameraFrustum = Frustum(camera.projectionMatrix * camera.viewMatrix);
+    std::array<Frustum, Configuration::SHADOW_CASCADE_COUNT> cascadeFrustums;
+    for (int i = 0; i < Configuration::SHADOW_CASCADE_COUNT; i++) {
+        cascadeFrustums[i] = Frustum(sun.lightProjection[i] * sun.lightView[i]);
+    }
+
+    auto view = registry.view<MultiInstancedMeshComponent, InstanceCullingComponent, TransformationComponent>();
+
+    // test the instances against the view frustum and collect the distances of the visible ones
+    std::vector<float> distances;
+    view.each([&](const MultiInstancedMeshComponent& mesh, InstanceCullingComponent& culling, const TransformationComponent& transform) {
+        for (const auto& [name, instances] : mesh.transforms) {
+            CulledInstances& culled = culling.instances[name];
+            const unsigned int instancesCount = instances.transformations.size();
+
+            if (culling.boundsOutdated || culled.bounds.size() != instancesCount) {
+                const auto& it = mesh.mesh->boundingSpheres.find(name);
+                const glm::vec4 boundingSphere = it != mesh.mesh->boundingSpheres.end() ? it->second : glm::vec4(0.0f, 0.0f, 0.0f, Configuration::cellSize);
+
+                updateInstanceBounds(culled, instances.transformations, transform.transform, boundingSphere);
+            }
+
+            culled.visibility.resize(instancesCount);
+            cameraFrustum.testSpheres(culled.bounds, culled.visibility);
+
+            culled.candidates.clear();
+            for (unsigned int i = 0; i < instancesCount; i++) {
+                if (!culled.visibility[i]) {
+                    continue;
+                }
+
+                const glm::vec3 center = glm::vec3(culled.bounds.x[i], culled.bounds.y[i], culled.bounds.z[i]);
+                const float distance = glm::length(center - cameraTransform.position);
+
+                if (distance < Configuration::vegetationDrawDistance && !occlusionBuffer.isOccluded(center, culled.bounds.radius[i])) {
+                    culled.candidates.emplace_back(i, distance);
+                    distances.push_back(distance);
+                }
+            }
+        }
+
+        culling.boundsOutdated = false;
+    });
+
+    // keep only the nearest instances if there are too many
+    float maxDistance = Configuration::vegetationDrawDistance;
+    if (distances.size() > Configuration::maxVegetationInstances) {
+        auto nth = distances.begin() + Configuration::maxVegetationInstances;
+        std::nth_element(distances.begin(), nth, distances.end());
+        maxDistance = *nth;
+    }
+
+    // compact the visible instances per detail level and upload them
+    view.each([&](const MultiInstancedMeshComponent& mesh, InstanceCullingComponent& culling, const TransformationComponent& transform) {
+        const unsigned int levelsCount = mesh.mesh->lods.size() + 1;
+        const unsigned int geometryLevelsCount = mesh.mesh->getGeometryLodCount();
+
+        for (const auto& [name, instances] : mesh.transforms) {
+            CulledInstances& culled = culling.instances.at(name);
+            const unsigned int instancesCount = instances.transformations.size();
+
+            if (culled.cameraInstances.size() != levelsCount) {
+                culled.visibleTransforms.resize(levelsCount);
+                culled.cameraInstances.resize(levelsCount);
+                culled.shadowInstances.resize(geometryLevelsCount);
+            }
+
+            for (auto& transforms : culled.visibleTransforms) {
+                transforms.clear();
+            }
+
+            for (const auto& [index, distance] : culled.candidates) {
+                if (distance < maxDistance) {
+                    const float screenSize = getScreenSize(camera, culled.bounds.radius[index], distance);
+                    const unsigned int level = mesh.mesh->selectLod(screenSize, culled.lodLevels[index], Configuration::lodHysteresis);
+                    culled.lodLevels[index] = level;
+
+                    culled.visibleTransforms[level].push_back(fadeInstance(instances.transformations[index], distance, maxDistance));
+                }
+            }
+
+            for (unsigned int level = 0; level < levelsCount; level++) {
+                culled.cameraInstances[level].streamBuffer(culled.visibleTransforms[level]);
+                culled.visibleTransforms[level].clear();
+            }
+
+            // instances outside of the view frustum can still cast visible shadows
+            for (int i = 0; i < Configuration::SHADOW_CASCADE_COUNT; i++) {
+                cascadeFrustums[i].testSpheres(culled.bounds, culled.visibility, i > 0);
+            }
+
+            for (unsigned int i = 0; i < instancesCount; i++) {
+                if (!culled.visibility[i]) {
+                    continue;
+                }
+
+                const glm::vec3 center = glm::vec3(culled.bounds.x[i], culled.bounds.y[i], culled.bounds.z[i]);
+                const float distance = glm::length(center - cameraTransform.position);
+
+                if (distance < maxDistance) {
+                    // impostors are camera facing and cannot cast correct shadows, so the coarsest geometry is used instead
+                    const float screenSize = getScreenSize(camera, culled.bounds.radius[i], distance);
+                    const unsigned int level = glm::min(mesh.mesh->selectLod(screenSize, culled.lodLevels[i], Configuration::lodHysteresis), geometryLevelsCount - 1);
+
+                    culled.visibleTransforms[level].push_back(fadeInstance(instances.transformations[i], distance, maxDistance));
+                }
+            }
+
+            for (unsigned int level = 0; level < geometryLevelsCount; level++) {
+                culled.shadowInstances[level].streamBuffer(culled.visibleTransforms[level]);
+            }
+        }
+    });
+}
+
+void RenderSystem::renderOcclusionBuffer() {
+    PROFILE_FUNCTION();
+    const auto& [camera, cameraTransform] = registry.get<CameraComponent, TransformationComponent>(game->camera);
+
+    const glm::mat4 viewProjection = camera.projectionMatrix * camera.viewMatrix;
+    const Frustum cameraFrustum = Frustum(viewProjection);
+
+    occlusionBuffer.clear(viewProjection);
+
+    registry.view<OccluderComponent, TransformationComponent>().each([&](auto entity, const OccluderComponent& occluder, const TransformationComponent& transform) {
+        // previews are not solid
+        const BuildingComponent* building = registry.try_get<BuildingComponent>(entity);
+        if (building != nullptr && building->preview) {
+            return;
+        }
+
+        const float scale = glm::max(glm::length(glm::vec3(transform.transform[0])), glm::max(glm::length(glm::vec3(transform.transform[1])), glm::length(glm::vec3(transform.transform[2]))));
+        const glm::vec3 center = glm::vec3(transform.transform * glm::vec4(glm::vec3(occluder.boundingSphere), 1.0f));
+        const float radius = scale * occluder.boundingSphere.w;
+
+        // only large occluders are worth rasterizing
+        if (!cameraFrustum.intersects(center, radius) || getScreenSize(camera, radius, glm::length(center - cameraTransform.position)) < Configuration::minOccluderScreenSize) {
+            return;
+        }
+
+        occlusionBuffer.addOccluder(occluder.triangles, transform.transform);
+    });
+
+    occlusionBuffer.rasterize();
+}
+
+bool RenderSystem::isOccluded(entt::entity entity, const MeshPtr& mesh, const glm::mat4& transform) const {
+    const TerrainComponent* terrain = registry.try_get<TerrainComponent>(entity);
+    if (terrain != nullptr) {
+        return isChunkOccluded(transform, terrain->minHeight, terrain->maxHeight);
+    }
+
+    const glm::vec4& boundingSphere = mesh->boundingSphere;
+    if (boundingSphere.w <= 0.0f) {
+        return false;
+    }
+
+    const float scale = glm::max(glm::length(glm::vec3(transform[0])), glm::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+    const glm::vec3 center = glm::vec3(transform * glm::vec4(glm::vec3(boundingSphere), 1.0f));
+
+    return occlusionBuffer.isOccluded(center, scale * boundingSphere.w);
+}
+
+bool RenderSystem::isChunkOccluded(const glm::mat4& transform, float minHeight, float maxHeight) const {
+    const glm::vec3 position = glm::vec3(transform[3]);
+
+    return occlusionBuffer.isOccluded(position + glm::vec3(0.0f, minHeight, 0.0f), position + glm::vec3(Configuration::chunkSize, maxHeight, Configuration::chunkSize));
+}
+
+void RenderSystem::updateMeshLods() const {
+    PROFILE_FUNCTION();
+    const auto& [camera, cameraTransform] = registry.get<CameraComponent, TransformationComponent>(game->camera);
+
+    registry.view<MeshComponent, TransformationComponent>().each([&](MeshComponent& mesh, const TransformationComponent& transform) {
+        if (mesh.mesh->lods.empty()) {
+            mesh.lod = 0;
+            return;
+        }
+
+        const glm::vec4& boundingSphere = mesh.mesh->boundingSphere;
+        const float scale = glm::max(glm::length(glm::vec3(transform.transform[0])), glm::max(glm::length(glm::vec3(transform.transform[1])), glm::length(glm::vec3(transform.transform[2]))));
+        const glm::vec3 center = glm::vec3(transform.transform * glm::vec4(glm::vec3(boundingSphere), 1.0f));
+
+        const float screenSize = getScreenSize(camera, scale * boundingSphere.w, glm::length(center - cameraTransform.position));
+
+        // impostors can only be rendered instanced
+        mesh.lod = glm::min(mesh.mesh->selectLod(screenSize, mesh.lod, Configuration::lodHysteresis), mesh.mesh->getGeometryLodCount() - 1);
+    });
+}
+
+void RenderSystem::updateInstanceBounds(CulledInstances& culled, const std::vector<glm::mat4>& transformations, const glm::mat4& model, const glm::vec4& boundingSphere) {
+    culled.bounds.clear();
+    culled.bounds.reserve(transformations.size());
+
+    for (const glm::mat4& transformation : transformations) {
+        const glm::mat4 instanceModel = model * transformation;
+        const float scale = glm::max(glm::length(glm::vec3(instanceModel[0])), glm::max(glm::length(glm::vec3(instanceModel[1])), glm::length(glm::vec3(instanceModel[2]))));
+
+        culled.bounds.push_back(glm::vec3(instanceModel * glm::vec4(glm::vec3(boundingSphere), 1.0f)), scale * boundingSphere.w);
+    }
+
+    culled.lodLevels.assign(transformations.size(), 0);
+}
+
+glm::mat4 RenderSystem::fadeInstance(const glm::mat4& transformation, float distance, float maxDistance) {
+    const float fadeStart = maxDistance - Configuration::vegetationFadeDistance;
+    if (distance <= fadeStart) {
+        return transformation;
+    }
+
+    const float factor = glm::clamp((maxDistance - distance) / Configuration::vegetationFadeDistance, 0.0f, 1.0f);
+
+    glm::mat4 result = transformation;
+    result[0] *= factor;
+    result[1] *= factor;
+    result[2] *= factor;
+
+    return result;
+}
+
+float RenderSystem::getScreenSize(const CameraComponent& camera, float radius, float distance) {
+    if (distance <= radius) {
+        return std::numeric_limits<float>::max();
+    }
+
+    return radius / (distance * glm::tan(0.5f * glm::radians(camera.fov)));
+}
+
+void RenderSystem::recordRoads(std::vector<DrawPacket>& packets, const RoadMeshComponent& road, const MeshRenderData& renderData) const {
+    for (const auto& [typeID, tiles] : road.roadMeshes) {
+        const std::string& roadPackName = getRoadTypeName(typeID);
+        const RoadPackPtr& pack = resourceManager.getResource<RoadPack>(roadPackName);
+
+        for (const auto& [tileType, instances] : tiles) {
+            DrawPacket& packet = packets.emplace_back(DrawPacket::Type::ROAD_INSTANCED, renderData);
+            packet.roadMesh = &pack->roadGeometries;
+            packet.tileType = tileType;
+            packet.instances = &instances.instanceBuffer;
+        }
+    }
+}
+
+void RenderSystem::recordSnapshot() {
+    PROFILE_FUNCTION();
+    snapshot.clear();
+
+    const auto& [camera, cameraTransform] = registry.get<CameraComponent, TransformationComponent>(game->camera);
+    const SunLightComponent& sun = registry.get<SunLightComponent>(game->sun);
+
+    snapshot.viewMatrix = camera.viewMatrix;
+    snapshot.projectionMatrix = camera.projectionMatrix;
+    snapshot.cameraPosition = cameraTransform.position;
+    snapshot.cameraTarget = cameraTransform.position + camera.front;
+    snapshot.width = camera.width;
+    snapshot.height = camera.height;
+
+    for (int i = 0; i < Configuration::SHADOW_CASCADE_COUNT; i++) {
+        snapshot.lightView[i] = sun.lightView[i];
+        snapshot.lightProjection[i] = sun.lightProjection[i];
+        snapshot.cascadeFarPlanes[i] = (camera.far - camera.near) * Configuration::CASCADE_FAR_PLANE_FACTORS[i] + camera.near;
+    }
+    snapshot.lightDirection = sun.direction;
+    snapshot.lightAmbient = sun.ambient;
+    snapshot.lightDiffuse = sun.diffuse;
+    snapshot.lightSpecular = sun.specular;
+
+#if DEBUG
+    const DebugComponent& debugComponent = registry.get<DebugComponent>(registry.view<DebugComponent>().front());
+    snapshot.showShadowMaps = debugComponent.mode == DebugMode::SHADOW_MAPS;
+#endif
+
+    recordSceneShadows(snapshot.shadowPackets, entt::exclude<DebugComponent, SunLightComponent, StaticBatchedComponent>);
+    recordScene(snapshot.cameraPackets, entt::exclude<DebugComponent, StaticBatchedComponent>);
+
+    if (game->debugMode) {
+        entt::entity debugEntity = registry.view<DebugComponent>().front();
+
+        const MeshComponent& mesh = registry.get<MeshComponent>(debugEntity);
+        const TransformationComponent& transform = registry.get<TransformationComponent>(debugEntity);
+
+        snapshot.cameraPackets.push_back(DrawPacket{DrawPacket::Type::MESH, MeshRenderData{transform.transform}, mesh.mesh.get()});
+    }
+}
+
+void RenderSystem::submitPackets(const std::vector<DrawPacket>& packets, Shader* shader) const {
+    RenderStats& stats = RenderStats::get();
+
+    for (const DrawPacket& packet : packets) {
+        switch (packet.type) {
+            case DrawPacket::Type::MESH:
+                stats.setCategory(RenderCategory::MESH);
+                packet.mesh->render(packet.renderData, shader);
+                break;
+            case DrawPacket::Type::INSTANCED:
+                stats.setCategory(RenderCategory::INSTANCED_MESH);
+                packet.mesh->renderInstanced<TransformationComponent>(packet.renderData, *packet.instances, shader);
+                break;
+            case DrawPacket::Type::OBJECT_INSTANCED:
+                stats.setCategory(RenderCategory::MULTI_INSTANCED_MESH);
+                packet.mesh->renderObjectInstanced<TransformationComponent>(*packet.object, packet.renderData, *packet.instances, shader);
+                break;
+            case DrawPacket::Type::ROAD_INSTANCED:
+                stats.setCategory(RenderCategory::ROAD_MESH);
+                packet.roadMesh->renderObjectInstanced<glm::mat4>(packet.tileType, packet.renderData, *packet.instances, shader);
+                break;
+#if DEBUG
+            case DrawPacket::Type::ROAD_DEBUG: {
+                stats.setCategory(RenderCategory::ROAD_MESH);
+                ShaderProgram* roadDebugPointsShader = resourceManager.getResource<Shader>("ROAD_DEBUG_POINTS_SHADER")->defaultShader;
+                ShaderProgram* roadDebugLinesShader = resourceManager.getResource<Shader>("ROAD_DEBUG_LINES_SHADER")->defaultShader;
+
+                roadDebugLinesShader->use();
+                roadDebugLinesShader->setMatrix4("model", packet.renderData.model);
+
+                packet.debugGeometry->draw();
+
+                glEnable(GL_PROGRAM_POINT_SIZE);
+                roadDebugPointsShader->use();
+                roadDebugPointsShader->setMatrix4("model", packet.renderData.model);
+
+                packet.debugGeometry->draw();
+                glDisable(GL_PROGRAM_POINT_SIZE);
+            } break;
+#endif
+            default:
+                break;
+        }
+    }
+
+    stats.setCategory(RenderCategory::OTHER);
+}
+
+void RenderSystem::uploadInstances() {
+    PROFILE_FUNCTION();
+    registry.view<InstancedMeshComponent>().each([](InstancedMeshComponent& mesh) {
+        if (mesh.bufferOutdated) {
+            mesh.instanceBuffer.streamBuffer(mesh.transformations);
+            mesh.bufferOutdated = false;
+        }
+    });
 }
 
 void RenderSystem::update(float dt) {
+    PROFILE_FUNCTION();
+    uploadInstances();
+    renderOcclusionBuffer();
+    cullInstances();
+    updateMeshLods();
+
+    recordSnapshot();
+}
+
+void RenderSystem::submit() const {
+    PROFILE_FUNCTION();
+    updateCameraBuffer();
+    updateLightBuffer();
+
+    GpuTimer* gpuTimer = game->getApp()->getGpuTimer();
+    RenderStats& stats = RenderStats::get();
+
     // shadows
+    gpuTimer->begin(RenderPass::SHADOW);
+    stats.setPass(RenderPass::SHADOW);
     shadowBuffer.use();
     glClear(GL_DEPTH_BUFFER_BIT);
 
     glCullFace(GL_FRONT);
-    renderSceneShadows(entt::exclude<DebugComponent, SunLightComponent>);
+    submitPackets(snapshot.shadowPackets, shadowShader.get());
 
     glCullFace(GL_BACK);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    gpuTimer->end(RenderPass::SHADOW);
+    stats.setPass(RenderPass::OTHER);
 
-    const CameraComponent& camera = registry.get<CameraComponent>(game->camera);
-    const SunLightComponent& sun = registry.get<SunLightComponent>(game->sun);
+    glBindFramebuffer(GL_FRAMEBUFFER, game->getApp()->getFramebuffer());
 
-    glClearColor(sun.diffuse.x, sun.diffuse.y, sun.diffuse.z, 1.0f);
-    glViewport(0, 0, camera.width, camera.height);
+    glClearColor(snapshot.lightDiffuse.x, snapshot.lightDiffuse.y, snapshot.lightDiffuse.z, 1.0f);
+    glViewport(0, 0, snapshot.width, snapshot.height);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 #if DEBUG
-    const entt::entity& debugEntity = registry.view<DebugComponent>().front();
-    const DebugComponent& debugComponent = registry.get<DebugComponent>(debugEntity);
-    if (debugComponent.mode == DebugMode::SHADOW_MAPS) {
+    if (snapshot.showShadowMaps) {
+        gpuTimer->begin(RenderPass::DEBUG);
+        stats.setPass(RenderPass::DEBUG);
         glDisable(GL_CULL_FACE);
         shadowMapRenderer.render(shadowBuffer);
         glEnable(GL_CULL_FACE);
+        gpuTimer->end(RenderPass::DEBUG);
+        stats.setPass(RenderPass::OTHER);
 
         return;
     }
 #endif
 
+    gpuTimer->begin(RenderPass::SCENE);
+    stats.setPass(RenderPass::SCENE);
     shadowBuffer.bindTextures();
 
-    renderScene(entt::exclude<DebugComponent>);
-
-    // if (game->getState() == GameState::BUILD_MODE) {
-    //     registry.view<TransformationComponent, MeshComponent, BuildingComponent>()
-    //         .each([&](const TransformationComponent& transform, const MeshComponent& mesh, const BuildingComponent& buildMarker) {
-    //             MeshRenderData renderData = {transform.transform};
-    //             mesh.mesh->render(renderData);
-    //         });
-    // }
-
-    if (game->debugMode) {
-        entt::entity debugEntity = registry.view<DebugComponent>().front();
-
-        // const DebugComponent& debug = registry.get<DebugComponent>(debugEntity);
-        const MeshComponent& mesh = registry.get<MeshComponent>(debugEntity);
-        const TransformationComponent& transform = registry.get<TransformationComponent>(debugEntity);
-
-        MeshRenderData renderData = {transform.transform};
-
-        mesh.mesh->render(renderData);
-    }
+    submitPackets(snapshot.cameraPackets);
+    gpuTimer->end(RenderPass::SCENE);
+    stats.setPass(RenderPass::OTHER);
 }
@@ -20,10 +20,15 @@
 #include "misc/configuration.hpp"
 #include "misc/coordinateTransform.hpp"
 #include "misc/direction.hpp"
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
 #include "misc/roads/roadPathGenerator.hpp"
 #include "misc/roads/roadTypes.hpp"
 #include "misc/utility.hpp"
 #include "resources/roadPack.hpp"
+#include "systems/terrainSystem.hpp"
+
+#include <algorithm>
 
 #if DEBUG
 #include <GL/gl.h>
@@ -31,6 +36,9 @@
 
 RoadSystem::RoadSystem(Game* game)
     : System(game) {
+    // the chunks are looked up in the terrain, which is filled by the terrain system
+    access.mainThread = true;
+    access.write<RoadComponent, RoadMeshComponent>().runAfter<TerrainSystem>();
 
     eventDispatcher.sink<BuildEvent>()
         .connect<&RoadSystem::handleBuildEvent>(*this);
@@ -45,16 +53,37 @@ void RoadSystem::init() {
 }
 
 void RoadSystem::update(float dt) {
+    PROFILE_FUNCTION();
     RoadPackPtr roadPack = resourceManager.getResource<RoadPack>("BASIC_ROADS");
 
+    // the tile transformations of the chunks are calculated in parallel, the buffers are filled on the main thread
+    std::vector<entt::entity> chunks;
     while (!chunksToUpdateMesh.empty()) {
         const entt::entity chunk = game->terrain.chunkEntities.at(chunksToUpdateMesh.front());
 
-        const auto& [road, roadMesh] = registry.get<RoadComponent, RoadMeshComponent>(chunk);
-        createRoadMesh(road, roadMesh);
+        if (std::find(chunks.begin(), chunks.end(), chunk) == chunks.end()) {
+            chunks.push_back(chunk);
+        }
         chunksToUpdateMesh.pop();
     }
 
+    std::vector<const RoadComponent*> roads;
+    for (const entt::entity chunk : chunks) {
+        roads.push_back(&registry.get<RoadComponent>(chunk));
+    }
+
+    std::vector<RoadTransforms> transforms(chunks.size());
+    JobSystem::get().parallelFor(0, chunks.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            transforms[i] = calculateRoadTransforms(*roads[i]);
+        }
+    });
+
+    for (int i = 0; i < chunks.size(); i++) {
+        RoadMeshComponent& roadMesh = registry.get<RoadMeshComponent>(chunks[i]);
+        createRoadMesh(*roads[i], roadMesh, transforms[i]);
+    }
+
     while (!roadsToBuild.empty()) {
         const glm::ivec2& pos = roadsToBuild.front();
 
@@ -119,8 +148,9 @@ void RoadSystem::update(float dt) {
     }
 }
 
-void RoadSystem::createRoadMesh(const RoadComponent& road, RoadMeshComponent& geometry) const {
-    std::map<RoadTypes, std::map<RoadTileTypes, std::vector<glm::mat4>>> transforms;
+RoadSystem::RoadTransforms RoadSystem::calculateRoadTransforms(const RoadComponent& road) {
+    PROFILE_FUNCTION();
+    RoadTransforms transforms;
     constexpr int sinValues[] = {0, 1, 0, -1};
     constexpr int cosValues[] = {1, 0, -1, 0};
 
@@ -137,6 +167,11 @@ void RoadSystem::createRoadMesh(const RoadComponent& road, RoadMeshComponent& ge
         }
     }
 
+    return transforms;
+}
+
+void RoadSystem::createRoadMesh(const RoadComponent& road, RoadMeshComponent& geometry, RoadTransforms& transforms) const {
+    PROFILE_FUNCTION();
     for (RoadTypes type = RoadTypes::BASIC_ROADS; type < RoadTypes::UNDEFINED; type++) {
         for (RoadTileTypes tileType = RoadTileTypes::NOT_CONNECTED; tileType < RoadTileTypes::CURVE_FULL; tileType++) {
             bool updateBuffer = false;
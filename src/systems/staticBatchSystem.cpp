@@ -0,0 +1,351 @@
+/*  Copyright (C) 2024  Philipp Geil <https://github.com/PhiGei2000>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "systems/staticBatchSystem.hpp"
+
+#include "components/components.hpp"
+#include "events/buildEvent.hpp"
+#include "misc/configuration.hpp"
+#include "misc/coordinateTransform.hpp"
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
+#include "misc/roads/roadTypes.hpp"
+#include "resources/roadPack.hpp"
+
+#include <chrono>
+#include <format>
+#include <limits>
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+StaticBatchSystem::StaticBatchSystem(Game* game)
+    : System(game) {
+    access.mainThread = true;
+    access.read<BuildingComponent, MeshComponent, TransformationComponent, RoadComponent, RoadMeshComponent>()
+        .write<StaticBatchComponent, StaticBatchedComponent>();
+
+    init();
+
+    eventDispatcher.sink<BuildEvent>()
+        .connect<&StaticBatchSystem::handleBuildEvent>(*this);
+
+    registry.on_destroy<StaticBatchedComponent>()
+        .connect<&StaticBatchSystem::onBatchedEntityDestroyed>(*this);
+}
+
+void StaticBatchSystem::init() {
+}
+
+void StaticBatchSystem::update(float dt) {
+    PROFILE_FUNCTION();
+    for (auto it = batchTasks.begin(); it != batchTasks.end();) {
+        BatchTask& task = it->second;
+
+        if (task.result.valid() && task.result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            finishBatchTask(it->first, task);
+            it = batchTasks.erase(it);
+        }
+        else {
+            it++;
+        }
+    }
+
+    for (auto it = dirtyChunks.begin(); it != dirtyChunks.end();) {
+        const glm::ivec2 chunkPosition = it->first;
+
+        if (!game->terrain.chunkLoaded(chunkPosition)) {
+            it = dirtyChunks.erase(it);
+            continue;
+        }
+
+        const entt::entity chunk = game->terrain.chunkEntities.at(chunkPosition);
+        StaticBatchComponent& batch = registry.get_or_emplace<StaticBatchComponent>(chunk);
+
+        // batches of destroyed members are only marked as dirty by the destroy callback
+        if (batch.valid) {
+            invalidateBatch(batch);
+        }
+
+        it->second -= dt;
+        if (it->second > 0.0f || batchTasks.contains(chunkPosition) || batchTasks.size() >= maxBatchTasks) {
+            it++;
+            continue;
+        }
+
+        startBatchTask(chunkPosition, chunk, batch);
+        it = dirtyChunks.erase(it);
+    }
+}
+
+void StaticBatchSystem::markDirty(const glm::ivec2& chunkPosition) {
+    if (!game->terrain.chunkLoaded(chunkPosition)) {
+        return;
+    }
+
+    const entt::entity chunk = game->terrain.chunkEntities.at(chunkPosition);
+    invalidateBatch(registry.get_or_emplace<StaticBatchComponent>(chunk));
+
+    dirtyChunks[chunkPosition] = Configuration::staticBatchSettleTime;
+}
+
+void StaticBatchSystem::invalidateBatch(StaticBatchComponent& batch) {
+    batch.revision++;
+
+    if (!batch.valid) {
+        return;
+    }
+
+    batch.valid = false;
+    for (const entt::entity entity : batch.members) {
+        if (registry.valid(entity)) {
+            registry.remove<StaticBatchedComponent>(entity);
+        }
+    }
+
+    batch.members.clear();
+    batch.mesh.reset();
+}
+
+void StaticBatchSystem::startBatchTask(const glm::ivec2& chunkPosition, const entt::entity chunk, StaticBatchComponent& batch) {
+    const TransformationComponent& chunkTransform = registry.get<TransformationComponent>(chunk);
+    const glm::mat4 worldToChunk = glm::inverse(chunkTransform.transform);
+    const ShaderPtr meshShader = resourceManager.getResource<Shader>("MESH_SHADER");
+
+    std::vector<BatchSource> sources;
+    std::vector<entt::entity> members;
+
+    // placed buildings
+    registry.view<BuildingComponent, MeshComponent, TransformationComponent>(entt::exclude<VelocityComponent>)
+        .each([&](auto entity, const BuildingComponent& building, const MeshComponent& mesh, const TransformationComponent& transform) {
+            if (building.preview || mesh.mesh->shader != meshShader) {
+                return;
+            }
+
+            const auto& [buildingChunk, _] = utility::normalizedWorldGridToNormalizedChunkGridCoords(building.gridPosition);
+            if (buildingChunk != chunkPosition) {
+                return;
+            }
+
+            const glm::mat4 transformation = worldToChunk * transform.transform;
+            std::vector<BatchSource> entitySources;
+
+            for (const auto& [name, geometries] : mesh.mesh->geometries) {
+                for (const auto& [material, geometry] : geometries) {
+                    const auto& meshGeometry = std::dynamic_pointer_cast<MeshGeometry>(geometry);
+
+                    // entities without cpu side geometry data are rendered on their own
+                    if (!meshGeometry || !meshGeometry->getData()) {
+                        return;
+                    }
+
+                    entitySources.emplace_back(material, meshGeometry->getData(), transformation);
+                }
+            }
+
+            sources.insert(sources.end(), entitySources.begin(), entitySources.end());
+            members.push_back(entity);
+        });
+
+    // roads, transformed the same way as the road instances
+    constexpr int sinValues[] = {0, 1, 0, -1};
+    constexpr int cosValues[] = {1, 0, -1, 0};
+
+    const RoadComponent& road = registry.get<RoadComponent>(chunk);
+    std::vector<BatchSource> roadSources;
+    bool containsRoads = true;
+
+    for (int x = 0; x < Configuration::cellsPerChunk && containsRoads; x++) {
+        for (int y = 0; y < Configuration::cellsPerChunk && containsRoads; y++) {
+            const RoadTile& tile = road.roadTiles[x][y];
+            if (!tile.notEmpty() || tile.tileType >= RoadTileTypes::CURVE_FULL) {
+                continue;
+            }
+
+            const RoadPackPtr& pack = resourceManager.getResource<RoadPack>(getRoadTypeName(tile.roadType));
+            const auto& it = pack->roadGeometries.geometries.find(tile.tileType);
+            if (it == pack->roadGeometries.geometries.end()) {
+                continue;
+            }
+
+            const glm::vec3& pos = static_cast<float>(Configuration::cellSize) * glm::vec3(x + 0.5f, 0, y + 0.5f);
+            float cos = cosValues[tile.rotation];
+            float sin = sinValues[tile.rotation];
+            const glm::mat4 transformation = glm::mat4(glm::vec4(cos, 0.0f, sin, 0.0f), glm::vec4(0.0f, 1.0f, 0.0f, 0.0f), glm::vec4(-sin, 0.0f, cos, 0.0f), glm::vec4(pos, 1.0f));
+
+            for (const auto& [material, geometry] : it->second) {
+                const auto& meshGeometry = std::dynamic_pointer_cast<MeshGeometry>(geometry);
+                if (!meshGeometry || !meshGeometry->getData()) {
+                    containsRoads = false;
+                    break;
+                }
+
+                roadSources.emplace_back(material, meshGeometry->getData(), transformation);
+            }
+        }
+    }
+
+    if (containsRoads) {
+        sources.insert(sources.end(), roadSources.begin(), roadSources.end());
+    }
+
+    if (sources.empty()) {
+        return;
+    }
+
+    BatchTask& task = batchTasks[chunkPosition];
+    task.revision = batch.revision;
+    task.members = std::move(members);
+    task.containsRoads = containsRoads && !roadSources.empty();
+    // batches only save draw calls, so they are built when the workers have nothing more urgent to do
+    task.result = JobSystem::get().async(
+        [sources = std::move(sources)]() {
+            return buildBatch(sources);
+        },
+        JobPriority::LOW);
+}
+
+void StaticBatchSystem::finishBatchTask(const glm::ivec2& chunkPosition, BatchTask& task) {
+    BatchResult result = task.result.get();
+
+    if (!game->terrain.chunkLoaded(chunkPosition)) {
+        return;
+    }
+
+    const entt::entity chunk = game->terrain.chunkEntities.at(chunkPosition);
+    StaticBatchComponent& batch = registry.get<StaticBatchComponent>(chunk);
+
+    // the chunk changed while the batch was created
+    if (batch.revision != task.revision) {
+        return;
+    }
+
+    for (const entt::entity entity : task.members) {
+        if (!registry.valid(entity)) {
+            markDirty(chunkPosition);
+            return;
+        }
+    }
+
+    batch.mesh = MeshPtr(new Mesh<>(resourceManager.getResource<Shader>("MESH_SHADER")));
+    auto& geometries = batch.mesh->geometries[""];
+
+    batch.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    batch.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (const auto& [material, data] : result) {
+        geometries.emplace_back(material, GeometryPtr(new MeshGeometry(data)));
+
+        for (const Vertex& vertex : data.vertices) {
+            batch.boundsMin = glm::min(batch.boundsMin, vertex.position);
+            batch.boundsMax = glm::max(batch.boundsMax, vertex.position);
+        }
+    }
+
+    batch.members = std::move(task.members);
+    for (const entt::entity entity : batch.members) {
+        registry.emplace_or_replace<StaticBatchedComponent>(entity, chunkPosition);
+    }
+
+    batch.containsRoads = task.containsRoads;
+    batch.valid = true;
+
+    game->log(std::format("STATIC_BATCH_SYSTEM: Batched chunk at {}, {} ({} entities, {} geometries)", chunkPosition.x, chunkPosition.y, batch.members.size(), geometries.size()));
+}
+
+StaticBatchSystem::BatchResult StaticBatchSystem::buildBatch(const std::vector<BatchSource>& sources) {
+    PROFILE_FUNCTION();
+    // group the geometries by material and culling mode
+    std::map<std::pair<Material*, bool>, std::pair<MaterialPtr, GeometryData>> batches;
+
+    for (const BatchSource& source : sources) {
+        auto& [material, data] = batches[std::make_pair(source.material.get(), source.data->culling)];
+        if (data.vertices.empty()) {
+            material = source.material;
+            data.culling = source.data->culling;
+        }
+
+        data.addData(source.data->transformVertices(source.transform));
+    }
+
+    BatchResult result;
+    result.reserve(batches.size());
+
+    for (auto& [_, batch] : batches) {
+        result.push_back(std::move(batch));
+    }
+
+    return result;
+}
+
+void StaticBatchSystem::onBatchedEntityDestroyed(entt::registry& registry, entt::entity entity) {
+    const StaticBatchedComponent& batched = registry.get<StaticBatchedComponent>(entity);
+
+    // the batch is invalidated in the next update, the component storage must not be modified here
+    if (!dirtyChunks.contains(batched.chunkPosition)) {
+        dirtyChunks[batched.chunkPosition] = Configuration::staticBatchSettleTime;
+    }
+}
+
+void StaticBatchSystem::handleBuildEvent(const BuildEvent& e) {
+    if (e.action != BuildAction::END || e.positions.empty()) {
+        return;
+    }
+
+    // lines and areas only carry their corner points, so the covered cells are walked like in the environment system
+    std::vector<glm::ivec2> cells;
+    switch (e.shape) {
+        case BuildShape::POINT:
+            cells.push_back(e.positions[0]);
+            break;
+        case BuildShape::LINE:
+            for (std::size_t i = 0; i + 1 < e.positions.size(); i++) {
+                const glm::ivec2 direction = glm::sign(e.positions[i + 1] - e.positions[i]);
+                glm::ivec2 current = e.positions[i];
+
+                while (current != e.positions[i + 1]) {
+                    cells.push_back(current);
+                    current += direction;
+                }
+            }
+
+            cells.push_back(e.positions.back());
+            break;
+        case BuildShape::AREA: {
+            const glm::ivec2 min = glm::min(e.positions[0], e.positions[1]);
+            const glm::ivec2 max = glm::max(e.positions[0], e.positions[1]);
+
+            for (int x = min.x; x <= max.x; x++) {
+                for (int y = min.y; y <= max.y; y++) {
+                    cells.emplace_back(x, y);
+                }
+            }
+        } break;
+    }
+
+    // roads update their neighbours so the surrounding chunks may change as well
+    std::unordered_set<glm::ivec2> chunks;
+    for (const glm::ivec2& position : cells) {
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                const auto& [chunk, _] = utility::normalizedWorldGridToNormalizedChunkGridCoords(position + glm::ivec2(dx, dy));
+                chunks.insert(chunk);
+            }
+        }
+    }
+
+    for (const glm::ivec2& chunk : chunks) {
+        markDirty(chunk);
+    }
+}
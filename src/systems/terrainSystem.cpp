@@ -19,6 +19,8 @@
 #include "events/buildEvent.hpp"
 #include "events/chunkEvents.hpp"
 #include "misc/coordinateTransform.hpp"
+#include "misc/jobSystem.hpp"
+#include "misc/profiler.hpp"
 #include "misc/terrain.hpp"
 #include "misc/terrainArea.hpp"
 #include "rendering/textureAtlas.hpp"
@@ -26,6 +28,7 @@
 
 #include <chrono>
 #include <format>
+#include <limits>
 
 const TextureAtlas TerrainSystem::atlas = TextureAtlas(64.0f, 128.0f, 2, 1);
 
@@ -35,6 +38,7 @@ void TerrainSystem::init() {
     terrainHeightScaleNoise.SetConstValue(Configuration::Terrain::heightSteps);
     terrainNoise.SetSourceModule(0, terrainHeightScaleNoise);
 
+    terrainBaseNoise.SetSeed(static_cast<int>(game->terrain.seed));
     terrainBaseNoise.SetFrequency(0.0001f);
     terrainBaseNoise.SetOctaveCount(4);
     terrainBaseNoise.SetLacunarity(1.9);
@@ -58,6 +62,7 @@ float TerrainSystem::getTerrainHeight(const glm::ivec2& position) const {
 }
 
 TerrainSystem::TerrainCreationData TerrainSystem::generateTerrain(const glm::ivec2& chunkPosition) const {
+    PROFILE_FUNCTION();
     TerrainSystem::TerrainCreationData data{
         new float*[Configuration::cellsPerChunk + 1],
         new TerrainSurfaceTypes*[Configuration::cellsPerChunk]};
@@ -181,6 +186,7 @@ unsigned int TerrainSystem::generateWaterQuadMesh(const glm::ivec2& position, co
 }
 
 std::pair<GeometryData, GeometryData> TerrainSystem::generateTerrainMesh(const glm::ivec2& chunkPosition, float** const heightMap, TerrainSurfaceTypes** const surfaceTypes) {
+    PROFILE_FUNCTION();
     std::vector<Vertex> terrainVertices;
     std::vector<unsigned int> terrainIndices;
     unsigned int currentTerrainIndex = 0;
@@ -212,6 +218,34 @@ std::pair<GeometryData, GeometryData> TerrainSystem::generateTerrainMesh(const g
     return std::make_pair(terrainData, waterData);
 }
 
+OccluderComponent TerrainSystem::generateTerrainOccluder(float** const heightValues) {
+    PROFILE_FUNCTION();
+    std::vector<glm::vec3> triangles;
+
+    for (int blockX = 0; blockX < Configuration::cellsPerChunk; blockX += occluderBlockSize) {
+        for (int blockY = 0; blockY < Configuration::cellsPerChunk; blockY += occluderBlockSize) {
+            const int endX = glm::min(blockX + occluderBlockSize, Configuration::cellsPerChunk);
+            const int endY = glm::min(blockY + occluderBlockSize, Configuration::cellsPerChunk);
+
+            float height = std::numeric_limits<float>::max();
+            for (int x = blockX; x <= endX; x++) {
+                for (int y = blockY; y <= endY; y++) {
+                    height = glm::min(height, heightValues[x][y]);
+                }
+            }
+
+            const glm::vec3 p0 = glm::vec3(blockX * Configuration::cellSize, height, blockY * Configuration::cellSize);
+            const glm::vec3 p1 = glm::vec3(endX * Configuration::cellSize, height, blockY * Configuration::cellSize);
+            const glm::vec3 p2 = glm::vec3(blockX * Configuration::cellSize, height, endY * Configuration::cellSize);
+            const glm::vec3 p3 = glm::vec3(endX * Configuration::cellSize, height, endY * Configuration::cellSize);
+
+            triangles.insert(triangles.end(), {p0, p1, p3, p0, p3, p2});
+        }
+    }
+
+    return OccluderComponent(triangles);
+}
+
 void TerrainSystem::updateTerrainMesh(const TerrainArea& area) const {
     const std::unordered_map<glm::ivec2, TerrainArea>& chunkAreas = area.getChunkAreas();
 
@@ -248,19 +282,25 @@ void TerrainSystem::updateTerrainMesh(const TerrainArea& area, MeshComponent& me
 
 TerrainSystem::TerrainSystem(Game* game)
     : System(game) {
+    // creates the chunk entities and uploads their meshes
+    access.mainThread = true;
+    access.structural = true;
+
     // game->getEventDispatcher().sink<BuildEvent>().connect<&TerrainSystem::handleBuildEvent>(*this);
 
     init();
 }
 
 void TerrainSystem::update(float dt) {
+    PROFILE_FUNCTION();
     MaterialPtr groundMaterial = resourceManager.getResource<Material>("GROUND_MATERIAL");
     MaterialPtr waterMaterial = resourceManager.getResource<Material>("WATER_MATERIAL");
     ShaderPtr meshShader = resourceManager.getResource<Shader>("MESH_SHADER");
 
     for (auto it = meshCreationTasks.begin(); it != meshCreationTasks.end();) {
         if (it->second.valid() && it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-            const glm::ivec2& chunkPos = it->first;
+            PROFILE_ZONE("TerrainSystem::uploadChunkMesh");
+            const glm::ivec2 chunkPos = it->first;
             const auto& [terrainGeometry, waterGeometry] = it->second.get();
 
             entt::entity chunk = game->terrain.chunkEntities[chunkPos];
@@ -272,20 +312,47 @@ void TerrainSystem::update(float dt) {
             mesh.mesh->shader = meshShader;
             terrain.meshGenerated = true;
 
+            // the bounds of the chunk are used for occlusion culling
+            terrain.minHeight = -0.2f * Configuration::cellSize;
+            terrain.maxHeight = std::numeric_limits<float>::lowest();
+            for (int x = 0; x <= Configuration::cellsPerChunk; x++) {
+                for (int y = 0; y <= Configuration::cellsPerChunk; y++) {
+                    terrain.minHeight = glm::min(terrain.minHeight, terrain.heightValues[x][y]);
+                    terrain.maxHeight = glm::max(terrain.maxHeight, terrain.heightValues[x][y]);
+                }
+            }
+
+            registry.emplace_or_replace<OccluderComponent>(chunk, generateTerrainOccluder(terrain.heightValues));
+
             it = meshCreationTasks.erase(it);
             game->log(std::format("TERRAIN_SYSTEM: Created chunk at {}, {}", chunkPos.x, chunkPos.y));
 
-            ChunkCreatedEvent e(chunk, chunkPos);
-            game->raiseEvent(e);
+            auto requestTime = chunkRequestTimes.extract(chunkPos);
+            const float latency = requestTime ? std::chrono::duration<float>(std::chrono::steady_clock::now() - requestTime.mapped()).count() : 0.0f;
+
+            game->postEvent(ChunkCreatedEvent(chunk, chunkPos, latency));
         }
         else {
             it++;
         }
     }
 
-    // generate terrain
+    // generate terrain height. The noise of the requested chunks is evaluated in parallel
+    std::vector<glm::ivec2> positions;
     while (chunksToGenerate.size() > 0) {
-        const glm::ivec2 position = chunksToGenerate.front();
+        positions.push_back(chunksToGenerate.front());
+        chunksToGenerate.pop();
+    }
+
+    std::vector<TerrainCreationData> creationData(positions.size());
+    JobSystem::get().parallelFor(0, positions.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            creationData[i] = generateTerrain(positions[i]);
+        }
+    });
+
+    for (int i = 0; i < positions.size(); i++) {
+        const glm::ivec2& position = positions[i];
 
         // create chunk and assign components
         const entt::entity chunkEntity = registry.create();
@@ -295,26 +362,22 @@ void TerrainSystem::update(float dt) {
         registry.emplace<RoadMeshComponent>(chunkEntity);
         game->terrain.chunkEntities[position] = chunkEntity;
 
-        // generate terrain height
-        const TerrainCreationData& creationData = generateTerrain(position);
-        terrain.heightValues = creationData.heightValues;
-        terrain.surfaceTypes = creationData.surfaceTypes;
-        chunksToGenerate.pop();
+        terrain.heightValues = creationData[i].heightValues;
+        terrain.surfaceTypes = creationData[i].surfaceTypes;
 
         chunksToCreateMesh.push(position);
     }
 
-    // create mesh
-    while (chunksToCreateMesh.size() > 0 && meshCreationTasks.size() < maxThreads) {
+    // create mesh. Not more meshes than workers are created at the same time, so that finished chunks are uploaded continuously
+    while (chunksToCreateMesh.size() > 0 && meshCreationTasks.size() < JobSystem::get().getWorkersCount()) {
         const glm::ivec2 position = chunksToCreateMesh.front();
 
         const entt::entity chunkEntity = game->terrain.chunkEntities[position];
         const TerrainComponent& terrain = registry.get<TerrainComponent>(chunkEntity);
 
-        meshCreationTasks.emplace_back(position, std::async(
-                                                     std::launch::async, [=, this]() {
-                                                         return generateTerrainMesh(position, terrain.heightValues, terrain.surfaceTypes);
-                                                     }));
+        meshCreationTasks.emplace_back(position, JobSystem::get().async([position, heightValues = terrain.heightValues, surfaceTypes = terrain.surfaceTypes]() {
+            return generateTerrainMesh(position, heightValues, surfaceTypes);
+        }));
 
         chunksToCreateMesh.pop();
     }
@@ -339,6 +402,7 @@ void TerrainSystem::update(float dt) {
                 // check if chunk already loaded and generate it if not
                 if (!game->terrain.chunkEntities.contains(chunkPos)) {
                     chunksToGenerate.push(chunkPos);
+                    chunkRequestTimes.try_emplace(chunkPos, std::chrono::steady_clock::now());
                 }
             }
         }